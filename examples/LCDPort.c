@@ -1,7 +1,7 @@
 #include <stdint.h>
+#include <stddef.h>
 #include "stm32f10x.h"
 #include "stm32f10x_conf.h"
-#include "LCDIntf.h"
 #include "LCDPort.h"
 
 /*   The purpose of this implementation is to verify LCDIntf work with
@@ -18,6 +18,7 @@
  *
  * (PORTA[0] belongs to VLDiscovery board -- User Button)
  *
+ *   There is a single display on PORTA, thus the port handle is not used.
  */
 
 enum {
@@ -26,60 +27,122 @@ enum {
     PORT_CE_BIT = 0x8,
 };
 
+static void init(void * port, int32_t lcdPortDataWidth);
+static void deinit(void * port);
+static void out4(void * port, int32_t v);
+static void out8(void * port, int32_t v);
+static int32_t in4(void * port);
+static int32_t in8(void * port);
+static void setDirection_Input8(void * port);
+static void setDirection_Output8(void * port);
+static void setDirection_Input4(void * port);
+static void setDirection_Output4(void * port);
+static void setRS(void * port);
+static void clearRS(void * port);
+static void setRW(void * port);
+static void clearRW(void * port);
+static void setCE(void * port);
+static void clearCE(void * port);
 static void setControlLine_portMode(int32_t mode);
-static void setInputModeOfDataLines(void);
+static void setInputModeOfDataLines(void * port);
+#if defined(LCD_PORT_BUS_CYCLES)
+static void writeByte(void * port, int32_t rs, int32_t value);
+static int32_t readByte(void * port, int32_t rs);
+static void setDataLinesMode(uint32_t mode);
+static void writeCycle(uint32_t rsBit, int32_t v);
+static int32_t readCycle(void * port, uint32_t rsBit);
+static void strobeCE(void);
+static void delayLoops(uint32_t loops);
+#endif
 
-void
-LCDPort_Init(int32_t lcdPortDataWidth)
+static int32_t portDataWidth = LCD_PORT_DATA_WIDTH_UNDEFINED;
+
+#if defined(LCD_PORT_BUS_CYCLES)
+/*   HD44780 bus timing at VCC = 2.7..4.5V (the figures at 5V are shorter):
+ * E is high for PWEH >= 450ns, the data show up tDDR <= 360ns after its
+ * rising edge.  A read samples the data at the end of the E pulse, so
+ * the pulse width covers both.  A GPIO access alone takes a few APB
+ * cycles only (80..200ns at 24MHz), hence the delay loop, sized from
+ * the core clock by init().
+ */
+enum {
+    LCD_E_PULSE_WIDTH_NS = 450,
+    // a turn of the loop is a decrement and a taken branch at least
+    DELAY_LOOP_MIN_CYCLES = 3,
+};
+
+static uint32_t ePulseLoops = 1;
+#endif
+
+const LCDPortOps LCDPort_STM32VLDiscovery = {
+    init, deinit,
+    setDirection_Input8, setDirection_Output8,
+    setDirection_Input4, setDirection_Output4,
+    out4, out8, in4, in8,
+    setRS, clearRS, setRW, clearRW, setCE, clearCE,
+#if defined(LCD_PORT_BUS_CYCLES)
+    writeByte, readByte
+#else
+    NULL, NULL
+#endif
+};
+
+static void
+init(void * port, int32_t lcdPortDataWidth)
 {
     // Enable Clock of PORTA
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
+    portDataWidth = lcdPortDataWidth;
+#if defined(LCD_PORT_BUS_CYCLES)
+    ePulseLoops = ((SystemCoreClock / 1000000) * LCD_E_PULSE_WIDTH_NS
+        + 999) / 1000 / DELAY_LOOP_MIN_CYCLES + 1;
+#endif
 
-    LCDPort_ClearCE();
-    LCDPort_ClearRS();
-    LCDPort_SetRW();
+    clearCE(port);
+    clearRS(port);
+    setRW(port);
 
     setControlLine_portMode(GPIO_Mode_Out_PP);
 
-    setInputModeOfDataLines();
+    setInputModeOfDataLines(port);
 }
 
-void
-LCDPort_Deinit(void)
+static void
+deinit(void * port)
 {
     setControlLine_portMode(GPIO_Mode_IN_FLOATING);
 
-    setInputModeOfDataLines();
+    setInputModeOfDataLines(port);
 }
 
-void
-LCDPort_Out4(int32_t v)
+static void
+out4(void * port, int32_t v)
 {
     uint32_t keepControlLines = GPIOA->ODR & 0x0E;
     GPIOA->ODR = ((v & 0x0F) << 8) | keepControlLines;
 }
 
-void
-LCDPort_Out8(int32_t v)
+static void
+out8(void * port, int32_t v)
 {
     uint32_t keepControlLines = GPIOA->ODR & 0x0E;
     GPIOA->ODR = ((v & 0xFF) << 4) | keepControlLines;
 }
 
-int32_t
-LCDPort_In4(void)
+static int32_t
+in4(void * port)
 {
     return ((GPIOA->IDR & 0x0F00) >> 8);
 }
 
-int32_t
-LCDPort_In8(void)
+static int32_t
+in8(void * port)
 {
     return ((GPIOA->IDR & 0x0FF0) >> 4);
 }
 
-void
-LCDPort_SetDirection_Input8(void)
+static void
+setDirection_Input8(void * port)
 {
     GPIO_InitTypeDef GPIO_InitStructure;
 
@@ -92,8 +155,8 @@ LCDPort_SetDirection_Input8(void)
     GPIO_Init(GPIOA, &GPIO_InitStructure);
 }
 
-void
-LCDPort_SetDirection_Output8(void) 
+static void
+setDirection_Output8(void * port) 
 {
     GPIO_InitTypeDef GPIO_InitStructure;
 
@@ -106,8 +169,8 @@ LCDPort_SetDirection_Output8(void)
     GPIO_Init(GPIOA, &GPIO_InitStructure);
 }
 
-void
-LCDPort_SetDirection_Input4(void)
+static void
+setDirection_Input4(void * port)
 {
     GPIO_InitTypeDef GPIO_InitStructure;
 
@@ -120,8 +183,8 @@ LCDPort_SetDirection_Input4(void)
     GPIO_Init(GPIOA, &GPIO_InitStructure);
 }
 
-void
-LCDPort_SetDirection_Output4(void) 
+static void
+setDirection_Output4(void * port) 
 {
     GPIO_InitTypeDef GPIO_InitStructure;
 
@@ -134,38 +197,38 @@ LCDPort_SetDirection_Output4(void)
     GPIO_Init(GPIOA, &GPIO_InitStructure);
 }
 
-void
-LCDPort_SetRS(void)
+static void
+setRS(void * port)
 {
     GPIOA->BSRR = PORT_RS_BIT;
 }
 
-void
-LCDPort_ClearRS(void)
+static void
+clearRS(void * port)
 {
     GPIOA->BSRR = PORT_RS_BIT << 16;
 }
 
-void
-LCDPort_SetRW(void)
+static void
+setRW(void * port)
 {
     GPIOA->BSRR = PORT_RW_BIT;
 }
 
-void
-LCDPort_ClearRW(void)
+static void
+clearRW(void * port)
 {
     GPIOA->BSRR = PORT_RW_BIT << 16;
 }
 
-void
-LCDPort_SetCE(void)
+static void
+setCE(void * port)
 {
     GPIOA->BSRR = PORT_CE_BIT;
 }
 
-void
-LCDPort_ClearCE(void)
+static void
+clearCE(void * port)
 {
     GPIOA->BSRR = PORT_CE_BIT << 16;
 }
@@ -183,13 +246,104 @@ setControlLine_portMode(int32_t mode)
 }
 
 static void
-setInputModeOfDataLines(void)
+setInputModeOfDataLines(void * port)
+{
+    if (LCD_PORT_DATA_WIDTH_8_BIT == portDataWidth) {
+        setDirection_Input8(port);
+    } else if (LCD_PORT_DATA_WIDTH_4_BIT == portDataWidth) {
+        setDirection_Input4(port);
+    }
+}
+
+#if defined(LCD_PORT_BUS_CYCLES)
+/*   Whole bus cycles: RS, RW and all the data lines are changed by a single
+ * BSRR store, the data lines direction by direct CRL/CRH stores.
+ */
+enum {
+    CR_MODE_OUTPUT_PP_50MHZ = 0x3,
+    CR_MODE_INPUT_FLOATING  = 0x4,
+};
+
+static void
+writeByte(void * port, int32_t rs, int32_t value)
 {
-    int32_t dataWidth = LCDIntf_GetPortDataWidth();
-    if (LCD_PORT_DATA_WIDTH_8_BIT == dataWidth) {
-        LCDPort_SetDirection_Input8();
-    } else if (LCD_PORT_DATA_WIDTH_4_BIT == dataWidth) {
-        LCDPort_SetDirection_Input4();
+    uint32_t rsBit = (rs) ? PORT_RS_BIT : PORT_RS_BIT << 16;
+
+    setDataLinesMode(CR_MODE_OUTPUT_PP_50MHZ);
+    if (LCD_PORT_DATA_WIDTH_8_BIT == portDataWidth) {
+        writeCycle(rsBit, value & 0xFF);
+    } else {
+        writeCycle(rsBit, (value >> 4) & 0x0F);
+        writeCycle(rsBit, value & 0x0F);
     }
 }
 
+static int32_t
+readByte(void * port, int32_t rs)
+{
+    uint32_t rsBit = (rs) ? PORT_RS_BIT : PORT_RS_BIT << 16;
+    int32_t v;
+
+    setDataLinesMode(CR_MODE_INPUT_FLOATING);
+    if (LCD_PORT_DATA_WIDTH_8_BIT == portDataWidth)
+        return readCycle(port, rsBit);
+
+    v = readCycle(port, rsBit) << 4;
+    v |= readCycle(port, rsBit);
+
+    return v;
+}
+
+static void
+setDataLinesMode(uint32_t mode)
+{
+    // PORTA[8..11] live in CRH, PORTA[4..7] in CRL
+    GPIOA->CRH = (GPIOA->CRH & 0xFFFF0000) | (mode * 0x1111);
+    if (LCD_PORT_DATA_WIDTH_8_BIT == portDataWidth)
+        GPIOA->CRL = (GPIOA->CRL & 0x0000FFFF) | (mode * 0x11110000);
+}
+
+static void
+writeCycle(uint32_t rsBit, int32_t v)
+{
+    uint32_t shift = (LCD_PORT_DATA_WIDTH_8_BIT == portDataWidth) ? 4 : 8;
+    uint32_t mask = (LCD_PORT_DATA_WIDTH_8_BIT == portDataWidth) ? 0xFF : 0x0F;
+    uint32_t set = (v & mask) << shift;
+    uint32_t reset = (~v & mask) << shift;
+
+    GPIOA->BSRR = rsBit | (PORT_RW_BIT << 16) | set | (reset << 16);
+    strobeCE();
+}
+
+static int32_t
+readCycle(void * port, uint32_t rsBit)
+{
+    int32_t v;
+
+    GPIOA->BSRR = rsBit | PORT_RW_BIT;
+    GPIOA->BSRR = PORT_CE_BIT;
+    delayLoops(ePulseLoops);
+    v = (LCD_PORT_DATA_WIDTH_8_BIT == portDataWidth)
+        ? in8(port) : in4(port);
+    GPIOA->BSRR = PORT_CE_BIT << 16;
+
+    return v;
+}
+
+static void
+strobeCE(void)
+{
+    GPIOA->BSRR = PORT_CE_BIT;
+    delayLoops(ePulseLoops);
+    GPIOA->BSRR = PORT_CE_BIT << 16;
+}
+
+static void
+delayLoops(uint32_t loops)
+{
+    volatile uint32_t n = loops;
+
+    while (n--)
+        ;
+}
+#endif /* #if defined(LCD_PORT_BUS_CYCLES) */
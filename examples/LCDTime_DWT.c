@@ -0,0 +1,68 @@
+#include <stdint.h>
+#include "stm32f10x.h"
+#include "LCDTime.h"
+
+/*   LCDTime on the DWT cycle counter of Cortex-M3: delays are counted in
+ * core clock cycles, so a 37us wait takes 37us rather than a SysTick
+ * period.  Timestamp_microseconds() has to be called at least once per
+ * counter wrap (2^32 cycles, about a minute at 72MHz) to keep track.
+ */
+
+#define DWT_CTRL   (*(volatile uint32_t *)0xE0001000)
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004)
+#define DEMCR      (*(volatile uint32_t *)0xE000EDFC)
+
+enum {
+    DEMCR_TRCENA = (1u << 24),
+    DWT_CTRL_CYCCNTENA = 1,
+    /* keeps microseconds * cyclesPerMicrosecond within 32 bits */
+    LONGEST_DELAY_STEP_US = 10000,
+};
+
+static uint32_t cyclesPerMicrosecond = 1;
+
+void
+LCDTime_Init(void)
+{
+    cyclesPerMicrosecond = SystemCoreClock / 1000000;
+
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+void
+Delay_microseconds(uint32_t microseconds)
+{
+    uint32_t step, start;
+
+    while (microseconds > 0) {
+        step = (microseconds < LONGEST_DELAY_STEP_US) ?
+            microseconds : LONGEST_DELAY_STEP_US;
+        start = DWT_CYCCNT;
+        while (DWT_CYCCNT - start < step * cyclesPerMicrosecond)
+            ;
+        microseconds -= step;
+    }
+}
+
+/*   LCDIntf_Poll() may call it from an ISR while the main loop calls it
+ * too, so the wrap tracking state is updated with interrupts masked.
+ */
+uint32_t
+Timestamp_microseconds(void)
+{
+    static uint32_t lastCycles = 0, cycles = 0, microseconds = 0;
+    uint32_t now, rs, primask = __get_PRIMASK();
+
+    __disable_irq();
+    now = DWT_CYCCNT;
+    cycles += now - lastCycles;
+    lastCycles = now;
+    microseconds += cycles / cyclesPerMicrosecond;
+    cycles %= cyclesPerMicrosecond;
+    rs = microseconds;
+    __set_PRIMASK(primask);
+
+    return rs;
+}
@@ -0,0 +1,33 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdint.h>
+#include <time.h>
+#include "LCDTime.h"
+
+/*   LCDTime for host builds (simulations, tests against real time) on
+ * top of the POSIX monotonic clock.
+ */
+
+void
+LCDTime_Init(void)
+{
+}
+
+void
+Delay_microseconds(uint32_t microseconds)
+{
+    uint32_t start = Timestamp_microseconds();
+
+    while (Timestamp_microseconds() - start <= microseconds)
+        ;
+}
+
+uint32_t
+Timestamp_microseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)now.tv_sec * 1000000u
+        + (uint32_t)(now.tv_nsec / 1000);
+}
@@ -0,0 +1,61 @@
+#include <stdint.h>
+#include "stm32f10x.h"
+#include "LCDTime.h"
+
+/*   LCDTime on SysTick, for cores without the DWT cycle counter.  SysTick
+ * keeps its 1ms period (SysTick_Config(SystemCoreClock / 1000), as the
+ * 'Demo' project sets it up); the microseconds within a period are read
+ * from its down counter.  LCDTime_SysTickHandler() has to be called from
+ * SysTick_Handler() (e.g. from TimingDelay_Decrement() of the 'Demo');
+ * while SysTick interrupts are held off, time stops after the first
+ * pending tick.
+ */
+
+static volatile uint32_t milliseconds = 0;
+static uint32_t ticksPerMicrosecond = 1;
+
+void
+LCDTime_SysTickHandler(void)
+{
+    ++milliseconds;
+}
+
+void
+LCDTime_Init(void)
+{
+    ticksPerMicrosecond = SystemCoreClock / 1000000;
+}
+
+void
+Delay_microseconds(uint32_t microseconds)
+{
+    uint32_t start = Timestamp_microseconds();
+
+    /* the time stamp of the start may be up to 1us old already */
+    while (Timestamp_microseconds() - start <= microseconds)
+        ;
+}
+
+/*   A reload whose tick is not counted yet (SysTick interrupts held off,
+ * or the call comes from a handler of higher priority) leaves the SysTick
+ * exception pending: the millisecond is added here then, and the counter
+ * read again, as the first read may have come before the reload.
+ */
+uint32_t
+Timestamp_microseconds(void)
+{
+    uint32_t base, ms, ticks;
+
+    /* the handler may run between the reads: read again then */
+    do {
+        base = milliseconds;
+        ms = base;
+        ticks = SysTick->LOAD - SysTick->VAL;
+        if (SCB->ICSR & SCB_ICSR_PENDSTSET) {
+            ticks = SysTick->LOAD - SysTick->VAL;
+            ++ms;
+        }
+    } while (base != milliseconds);
+
+    return ms * 1000 + ticks / ticksPerMicrosecond;
+}
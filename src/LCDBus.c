@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdint.h>
+#include "LCDBus.h"
+
+static int32_t beginBroadcast(LCDBus * bus);
+static int32_t endBroadcast(LCDBus * bus);
+
+/* ==== Public Interface ================================================ */
+
+void
+LCDBus_Init(LCDBus * bus)
+{
+    bus->count = 0;
+    bus->broadcast = NULL;
+}
+
+/*   Takes an initialized interface; from now on its output is to be
+ * queued (LCDIntf_QueueInstruction()/LCDIntf_QueueData()) and served by
+ * the bus -- a blocking call would keep the other displays waiting.
+ */
+int32_t
+LCDBus_Attach(LCDBus * bus, LCDIntf * intf)
+{
+    if (LCD_BUS_MAX_DISPLAYS <= bus->count)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    if (bus->count)
+        LCDIntf_ShareBus(intf, bus->displays[0]);
+    bus->displays[bus->count++] = intf;
+
+    return LCD_OPERATION_OK;
+}
+
+/*   One step of every display: a byte is sent to each display which is
+ * ready for it, the others are checked for readiness.
+ *   Returns LCD_OPERATION_PENDING while any display has work left,
+ * LCD_OPERATION_OK once all of them are done, and LCD_OPERATION_TIMEOUT
+ * if a display did not get ready in time (its queue goes on regardless).
+ */
+int32_t
+LCDBus_Poll(LCDBus * bus)
+{
+    int32_t rs, status = LCD_OPERATION_OK;
+    size_t i;
+
+    for (i = 0; i < bus->count; ++i) {
+        rs = LCDIntf_Poll(bus->displays[i]);
+        if ((LCD_OPERATION_TIMEOUT == rs)
+                || ((LCD_OPERATION_PENDING == rs)
+                    && (LCD_OPERATION_OK == status)))
+            status = rs;
+    }
+
+    return status;
+}
+
+/*   all: an initialized interface whose port raises the E lines of every
+ * display on the bus together.  The controllers can't answer a read all
+ * at once, thus it is switched to LCD_BUSY_MODE_WRITE_ONLY.  To be set
+ * once the displays are attached.
+ */
+int32_t
+LCDBus_SetBroadcast(LCDBus * bus, LCDIntf * all)
+{
+    if (0 == bus->count)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    LCDIntf_ShareBus(all, bus->displays[0]);
+    LCDIntf_SetBusyMode(all, LCD_BUSY_MODE_WRITE_ONLY);
+    bus->broadcast = all;
+
+    return LCD_OPERATION_OK;
+}
+
+/*   One init sequence for all the controllers; its steps are timed by
+ * delays, not by busy flags.
+ */
+int32_t
+LCDBus_InitializeLCDControllers(LCDBus * bus)
+{
+    int32_t rs, status;
+
+    if (NULL == bus->broadcast)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    status = LCDIntf_InitializeLCDController(bus->broadcast);
+    if (LCD_OPERATION_OK != (rs = endBroadcast(bus)))
+        status = rs;
+
+    return status;
+}
+
+/*   Broadcasts wait for all the displays to get ready and return once all
+ * of them have executed the write, like a write followed by
+ * LCDIntf_WaitWhileBusy() on every display.  Queued operations go first.
+ */
+int32_t
+LCDBus_BroadcastInstruction(LCDBus * bus, int32_t instr)
+{
+    int32_t status;
+
+    if (LCD_OPERATION_OK != (status = beginBroadcast(bus)))
+        return status;
+
+    LCDIntf_WriteInstruction(bus->broadcast, instr);
+
+    return endBroadcast(bus);
+}
+
+int32_t
+LCDBus_BroadcastDataBurst(LCDBus * bus, const uint8_t * buf, size_t n)
+{
+    int32_t rs, status;
+
+    if (LCD_OPERATION_OK != (status = beginBroadcast(bus)))
+        return status;
+
+    status = LCDIntf_WriteDataBurst(bus->broadcast, buf, n);
+    if (LCD_OPERATION_OK != (rs = endBroadcast(bus)))
+        status = rs;
+
+    return status;
+}
+
+/*   Blocks until the queues of all displays have been executed. */
+int32_t
+LCDBus_Drain(LCDBus * bus)
+{
+    int32_t rs, status = LCD_OPERATION_OK;
+
+    while (LCD_OPERATION_OK != (rs = LCDBus_Poll(bus))) {
+        if (LCD_OPERATION_TIMEOUT == rs)
+            status = rs;
+    }
+
+    return status;
+}
+
+/* ==== Private Implementation ========================================== */
+
+static int32_t
+beginBroadcast(LCDBus * bus)
+{
+    int32_t rs, status;
+    size_t i;
+
+    if (NULL == bus->broadcast)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    status = LCDBus_Drain(bus);
+    for (i = 0; i < bus->count; ++i) {
+        if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(bus->displays[i])))
+            status = rs;
+        LCDIntf_AwaitReadinessOf(bus->broadcast, bus->displays[i]);
+    }
+
+    return status;
+}
+
+static int32_t
+endBroadcast(LCDBus * bus)
+{
+    int32_t rs, status = LCD_OPERATION_OK;
+    size_t i;
+
+    for (i = 0; i < bus->count; ++i) {
+        LCDIntf_AwaitReadinessOf(bus->displays[i], bus->broadcast);
+        if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(bus->displays[i])))
+            status = rs;
+    }
+
+    return status;
+}
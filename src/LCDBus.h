@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_LCDBus_h
+#define D_LCDBus_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LCDIntf.h"
+
+/*   Displays sharing the data and RS/RW lines, each selected by an E line
+ * of its own (i.e. by its own port handle).  The bus serves the queues of
+ * its displays in turns, a single step per display: while one display
+ * executes its byte, the next one gets its own, so a refresh of N
+ * displays takes about as long as the one of the slowest.
+ *   With a broadcast interface set, the bus also writes to all displays
+ * at once: the init sequence, a common clear or identical content cost
+ * about what they cost for a single display.  Broadcasts bypass the
+ * interfaces of the displays, thus LCDDriver instances on top of them
+ * have to drop their address caches (LCDDriver_InvalidateAddressCache()).
+ */
+#ifndef LCD_BUS_MAX_DISPLAYS
+#define LCD_BUS_MAX_DISPLAYS 4
+#endif
+
+typedef struct LCDBus {
+    LCDIntf * displays[LCD_BUS_MAX_DISPLAYS];
+    size_t    count;
+    LCDIntf * broadcast;            // raises every E line, or NULL
+} LCDBus;
+
+void    LCDBus_Init(LCDBus * bus);
+int32_t LCDBus_Attach(LCDBus * bus, LCDIntf * intf);
+int32_t LCDBus_Poll(LCDBus * bus);
+int32_t LCDBus_Drain(LCDBus * bus);
+
+int32_t LCDBus_SetBroadcast(LCDBus * bus, LCDIntf * all);
+int32_t LCDBus_InitializeLCDControllers(LCDBus * bus);
+int32_t LCDBus_BroadcastInstruction(LCDBus * bus, int32_t instr);
+int32_t LCDBus_BroadcastDataBurst(LCDBus * bus, const uint8_t * buf,
+        size_t n);
+
+#endif /* #ifndef D_LCDBus_h */
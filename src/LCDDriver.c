@@ -28,53 +28,307 @@
 
 #include <stdint.h>
 #include "LCDDriver.h"
-#include "LCDIntf.h"
 
-static int16_t screenWidth  = 8;
-static int16_t screenHeight = 1;
+/*   Where the flush of the rows of one controller stands: the run being
+ * written, and the cell written last, which is marked clean once the
+ * controller has executed it.
+ */
+typedef struct FlushCursor {
+    LCDDriverController * ctl;
+    int16_t  x;
+    int16_t  y;
+    int16_t  runEnd;
+    int16_t  lastRow;
+    int32_t  pendingIdx;
+    int8_t   done;
+} FlushCursor;
+
+static int32_t checkFault(LCDDriver * lcd);
+static int32_t trackFault(LCDDriver * lcd, int32_t rs);
+static int32_t resetShadow(LCDDriver * lcd);
+static int32_t readCell(LCDDriver * lcd, uint8_t * pCh);
+static void markCellDirty(LCDDriver * lcd, int32_t idx);
+static void markCellClean(LCDDriver * lcd, int32_t idx);
+static int32_t isCellDirty(LCDDriver * lcd, int32_t idx);
+static void putShadowCell(LCDDriver * lcd, int16_t x, int16_t y, int32_t ch);
+static int16_t findEndOfDirtyRun(LCDDriver * lcd, int16_t x, int16_t y);
+static int32_t flushRun(LCDDriver * lcd, int16_t x, int16_t runEnd,
+        int16_t y);
+static void selectControllerOfRow(LCDDriver * lcd, int16_t y);
+static void forgetAddresses(LCDDriver * lcd);
+static int32_t flushSideBySide(LCDDriver * lcd);
+static int16_t endOfSegment(LCDDriver * lcd, int16_t x);
+static int32_t putStretch(LCDDriver * lcd, int16_t x, int16_t y,
+        const uint8_t * cells, int16_t n);
+static int32_t rowsAreWholeLines(LCDDriver * lcd);
+static int32_t homeDisplay(LCDDriver * lcd);
+static int32_t marqueeChar(const LCDDriverMarquee * m, int32_t pos);
+static int32_t refillMarquee(LCDDriver * lcd, int32_t end);
+static void startFlushCursor(LCDDriver * lcd, FlushCursor * fc, int8_t i);
+static int32_t flushStep(LCDDriver * lcd, FlushCursor * fc);
+static int32_t confirmFlushStep(LCDDriver * lcd, FlushCursor * fc);
+static int32_t findNextRun(LCDDriver * lcd, FlushCursor * fc);
+
+enum {
+    DDRAM_2ND_LINE_ADDR = 0x40,
+    DDRAM_1ST_LINE_LAST_ADDR = 0x27,
+    DDRAM_2ND_LINE_LAST_ADDR = 0x67,
+    DDRAM_ADDR_MASK = 0x7F,
+    DDRAM_ADDR_UNKNOWN = -1,
+    DDRAM_LINE_LENGTH = 40,
+};
+
+/*   A single lookup: the segment of the cell gives the base address. */
+static uint32_t
+ddramAddress(LCDDriver * lcd, int16_t x, int16_t y)
+{
+    const LCDGeometry * g = lcd->geometry;
+    int32_t cell = y * g->columns + x;
+    uint32_t addr;
+
+    addr = g->segmentBase[cell / g->segmentWidth] + cell % g->segmentWidth;
+
+    return addr & DDRAM_ADDR_MASK;
+}
+
+/* The address counter follows the auto-increment of the 2-line mode. */
+static int32_t
+nextDDRAMAddress(int32_t addr)
+{
+    if (DDRAM_ADDR_UNKNOWN == addr)
+        return DDRAM_ADDR_UNKNOWN;
+    if (DDRAM_1ST_LINE_LAST_ADDR == addr)
+        return DDRAM_2ND_LINE_ADDR;
+    if (DDRAM_2ND_LINE_LAST_ADDR == addr)
+        return 0;
+    return addr + 1;
+}
+
+/*   The helpers below talk to the controller of the cursor row. */
+static int32_t
+setDDRAMAddress(LCDDriver * lcd, uint32_t addr)
+{
+    LCDDriverController * ctl = lcd->ctl;
+    int32_t rs;
+
+    if ((int32_t)addr == ctl->ddramAddrCache)
+        return LCD_OPERATION_OK;
 
+    LCDIntf_WriteInstruction(ctl->intf, SET_DDRAM_ADDRESS_CMD | addr);
+
+    rs = LCDIntf_WaitWhileBusy(ctl->intf);
+    ctl->ddramAddrCache = (LCD_OPERATION_OK == rs) ? addr : DDRAM_ADDR_UNKNOWN;
+
+    return rs;
+}
+
+static int32_t
+writeCell(LCDDriver * lcd, int32_t ch)
+{
+    LCDDriverController * ctl = lcd->ctl;
+    int32_t rs;
+
+    LCDIntf_WriteData(ctl->intf, ch);
+
+    rs = LCDIntf_WaitWhileBusy(ctl->intf);
+    ctl->ddramAddrCache = (LCD_OPERATION_OK == rs) ?
+        nextDDRAMAddress(ctl->ddramAddrCache) : DDRAM_ADDR_UNKNOWN;
+
+    return rs;
+}
+
+/* Reading DDRAM moves the address counter on, just as writing does. */
+static int32_t
+readCell(LCDDriver * lcd, uint8_t * pCh)
+{
+    LCDDriverController * ctl = lcd->ctl;
+    int32_t ch, rs;
+
+    if ((ch = LCDIntf_ReadData(ctl->intf)) < 0) {
+        ctl->ddramAddrCache = DDRAM_ADDR_UNKNOWN;
+        return LCD_OPERATION_UNSUPPORTED;
+    }
+    *pCh = ch;
+
+    rs = LCDIntf_WaitWhileBusy(ctl->intf);
+    ctl->ddramAddrCache = (LCD_OPERATION_OK == rs) ?
+        nextDDRAMAddress(ctl->ddramAddrCache) : DDRAM_ADDR_UNKNOWN;
+
+    return rs;
+}
+
+static int32_t
+writeCells(LCDDriver * lcd, const uint8_t * cells, int16_t n)
+{
+    LCDDriverController * ctl = lcd->ctl;
+    int32_t rs;
+
+    rs = LCDIntf_WriteDataBurst(ctl->intf, cells, n);
+    if (LCD_OPERATION_OK != rs) {
+        ctl->ddramAddrCache = DDRAM_ADDR_UNKNOWN;
+        return rs;
+    }
+
+    while (n--)
+        ctl->ddramAddrCache = nextDDRAMAddress(ctl->ddramAddrCache);
+
+    return rs;
+}
+
+/* ==== Public Interface ================================================ */
+
+/*   Binds the driver to an initialized interface instance; the screen is
+ * 8x1 until told otherwise.
+ */
+void
+LCDDriver_Init(LCDDriver * lcd, LCDIntf * intf)
+{
+    lcd->controllers[0].intf = intf;
+    lcd->controllers[0].ddramAddrCache = DDRAM_ADDR_UNKNOWN;
+    lcd->controllerCount = 1;
+    lcd->ctl = &lcd->controllers[0];
+    lcd->shadowEnabled = 0;
+    LCDDriver_SetupGeometry(lcd, &LCDGeometry_8x1);
+    lcd->cursorX = 0;
+    lcd->cursorY = 0;
+    lcd->faulted = 0;
+    lcd->reprobeAt = 0;
+    lcd->marquee.text = 0;
+}
+
+/*   The second controller of a 40x4 module, on the same bus as the first
+ * one (LCDIntf_ShareBus()); it takes rows 2-3 over.
+ */
+int32_t
+LCDDriver_AddController(LCDDriver * lcd, LCDIntf * intf)
+{
+    LCDDriverController * ctl;
+
+    if (LCDDRIVER_MAX_CONTROLLERS <= lcd->controllerCount)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    ctl = &lcd->controllers[lcd->controllerCount++];
+    ctl->intf = intf;
+    ctl->ddramAddrCache = DDRAM_ADDR_UNKNOWN;
+
+    return LCD_OPERATION_OK;
+}
+
+/*   Both controllers of a two-controller display clear at once. */
 int32_t
-LCDDriver_Clear(void)
+LCDDriver_Clear(LCDDriver * lcd)
 {
-    LCDIntf_WriteInstruction(DISPLAY_CLEAR);
+    LCDDriverController * ctl;
+    int16_t x, y;
+    int32_t rs, status = LCD_OPERATION_OK;
+    int8_t i;
+
+    if (lcd->shadowEnabled) {
+        for (y = 0; y < lcd->screenHeight; ++y)
+            for (x = 0; x < lcd->screenWidth; ++x)
+                putShadowCell(lcd, x, y, ' ');
+        lcd->cursorX = lcd->cursorY = 0;
+        return LCD_OPERATION_OK;
+    }
 
-    return LCDIntf_WaitWhileBusy();
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
+
+    // the clear shifts the display home, too
+    lcd->marquee.text = 0;
+    for (i = 0; i < lcd->controllerCount; ++i)
+        LCDIntf_WriteInstruction(lcd->controllers[i].intf, DISPLAY_CLEAR);
+
+    for (i = 0; i < lcd->controllerCount; ++i) {
+        ctl = &lcd->controllers[i];
+        rs = LCDIntf_WaitWhileBusy(ctl->intf);
+        if (LCD_OPERATION_OK == rs) {
+            ctl->ddramAddrCache = 0;
+        } else {
+            ctl->ddramAddrCache = DDRAM_ADDR_UNKNOWN;
+            status = rs;
+        }
+    }
+    lcd->ctl = &lcd->controllers[0];
+
+    return trackFault(lcd, status);
 }
 
+/*   The layout of 20x4-like displays: rows 2-3 go on after the end of
+ * rows 0-1 in DDRAM.  With a second controller added, rows 2-3 of a
+ * 4-row screen are rows 0-1 of that controller.
+ */
 void
-LCDDriver_SetupScreenDimensions(int16_t width, int16_t height)
+LCDDriver_SetupScreenDimensions(LCDDriver * lcd, int16_t width,
+        int16_t height)
 {
-    screenWidth  = width;
-    screenHeight = height;
+    LCDGeometry * g = &lcd->ownGeometry;
+    int16_t i;
+
+    if (height > LCD_GEOMETRY_MAX_SEGMENTS)
+        height = LCD_GEOMETRY_MAX_SEGMENTS;
+
+    g->columns = width;
+    g->rows = height;
+    g->controllers = ((lcd->controllerCount > 1) && (height > 2)) ? 2 : 1;
+    g->segmentWidth = (width > 0) ? width : 1;
+    for (i = 0; i < LCD_GEOMETRY_MAX_SEGMENTS; ++i) {
+        g->segmentBase[i] = DDRAM_2ND_LINE_ADDR * (i & 0x01);
+        if (1 == g->controllers)
+            g->segmentBase[i] += width * (i >> 1);
+    }
+
+    LCDDriver_SetupGeometry(lcd, g);
+}
+
+/*   The descriptor is used in place: it has to outlive its use.  A
+ * geometry of two controllers needs the second one added first.
+ */
+int32_t
+LCDDriver_SetupGeometry(LCDDriver * lcd, const LCDGeometry * geometry)
+{
+    if (geometry->controllers > lcd->controllerCount)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    lcd->geometry = geometry;
+    lcd->screenWidth  = geometry->columns;
+    lcd->screenHeight = geometry->rows;
+    lcd->ctl = &lcd->controllers[0];
+
+    if (lcd->shadowEnabled && (LCD_OPERATION_OK != resetShadow(lcd)))
+        lcd->shadowEnabled = 0;
+
+    return LCD_OPERATION_OK;
 }
 
 static void
-resetInvalidValuesOfCoordinates(int16_t * pX, int16_t * pY)
+resetInvalidValuesOfCoordinates(LCDDriver * lcd, int16_t * pX, int16_t * pY)
 {
-    if ((*pX < 0) || (*pX >= screenWidth))
+    if ((*pX < 0) || (*pX >= lcd->screenWidth))
         *pX = 0;
-    if ((*pY < 0) || (*pY >= screenHeight))
+    if ((*pY < 0) || (*pY >= lcd->screenHeight))
         *pY = 0;
 }
 
-enum {
-    DDRAM_2ND_LINE_ADDR = 0x40,
-    DDRAM_ADDR_MASK = 0x7F,
-};
-
 int32_t
-LCDDriver_GotoXY(int16_t x, int16_t y)
+LCDDriver_GotoXY(LCDDriver * lcd, int16_t x, int16_t y)
 {
-    uint32_t addr;
+    int32_t rs;
 
-    resetInvalidValuesOfCoordinates(&x, &y);
+    resetInvalidValuesOfCoordinates(lcd, &x, &y);
 
-    addr =  x + DDRAM_2ND_LINE_ADDR * (y & 0x01) + screenWidth * (y >> 1);
-    addr &= DDRAM_ADDR_MASK;
+    if (lcd->shadowEnabled) {
+        lcd->cursorX = x;
+        lcd->cursorY = y;
+        return LCD_OPERATION_OK;
+    }
 
-    LCDIntf_WriteInstruction(SET_DDRAM_ADDRESS_CMD | addr);
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
 
-    return LCDIntf_WaitWhileBusy();
+    selectControllerOfRow(lcd, y);
+
+    return trackFault(lcd, setDDRAMAddress(lcd, ddramAddress(lcd, x, y)));
 }
 
 static void
@@ -85,27 +339,704 @@ resetInvalidCharCodeToSafeDefault(int32_t * pCh)
 }
 
 int32_t
-LCDDriver_Putc(int32_t ch)
+LCDDriver_Putc(LCDDriver * lcd, int32_t ch)
 {
+    int32_t rs;
+
     resetInvalidCharCodeToSafeDefault(&ch);
 
-    LCDIntf_WriteData(ch);
+    if (lcd->shadowEnabled) {
+        // like DDRAM, cells past the right edge swallow the characters
+        if (lcd->cursorX < lcd->screenWidth)
+            putShadowCell(lcd, lcd->cursorX, lcd->cursorY, ch);
+        ++lcd->cursorX;
+        return LCD_OPERATION_OK;
+    }
 
-    return LCDIntf_WaitWhileBusy();
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
+
+    return trackFault(lcd, writeCell(lcd, ch));
 }
 
+/*   Without the shadow the string goes out in bursts of up to a DDRAM line;
+ * the first failed burst ends the output.
+ */
 int32_t
-LCDDriver_Puts(int8_t * str)
+LCDDriver_Puts(LCDDriver * lcd, int8_t * str)
 {
-    int32_t rs = -1;
-    uint32_t i = 0;
+    uint8_t burst[DDRAM_LINE_LENGTH];
+    int32_t ch, rs = LCD_OPERATION_OK;
+    int16_t i, n;
+
+    if (lcd->shadowEnabled) {
+        for (i = 0; str && str[i] && i < lcd->screenWidth; ++i)
+            LCDDriver_Putc(lcd, str[i]);
+        return LCD_OPERATION_OK;
+    }
+
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
 
     if ((str == 0) || (*str == '\0'))
-        return LCDIntf_WaitWhileBusy();
+        return trackFault(lcd, LCDIntf_WaitWhileBusy(lcd->ctl->intf));
+
+    for (i = 0; str[i] && (i < lcd->screenWidth); i += n) {
+        for (n = 0; str[i + n] && (i + n < lcd->screenWidth)
+                && (n < DDRAM_LINE_LENGTH); ++n) {
+            ch = str[i + n];
+            resetInvalidCharCodeToSafeDefault(&ch);
+            burst[n] = ch;
+        }
+        if (LCD_OPERATION_OK != (rs = writeCells(lcd, burst, n)))
+            break;
+    }
+
+    return trackFault(lcd, rs);
+}
+
+/*   Text from (x, y) on, row after row: '\n' starts the next row, a full
+ * row is wrapped or clipped as mode tells; the output ends with the last
+ * row.  Every stretch of a row goes out as a single address set (none if
+ * the address counter is there already) and a single burst.  pWritten,
+ * if not NULL, gets the count of characters put on the screen, up to
+ * the first failed burst.
+ */
+int32_t
+LCDDriver_PutText(LCDDriver * lcd, int16_t x, int16_t y,
+        const int8_t * str, int32_t mode, int16_t * pWritten)
+{
+    uint8_t burst[DDRAM_LINE_LENGTH];
+    int32_t ch, rs = LCD_OPERATION_OK;
+    int16_t n, end, written = 0;
+
+    resetInvalidValuesOfCoordinates(lcd, &x, &y);
+
+    if (!lcd->shadowEnabled && (LCD_OPERATION_OK != (rs = checkFault(lcd))))
+        goto out;
+
+    while (str && *str && (y < lcd->screenHeight)) {
+        if ('\n' == *str) {
+            ++str;
+            x = 0;
+            ++y;
+            continue;
+        }
+        if (x >= lcd->screenWidth) {
+            if (LCDDRIVER_TEXT_CLIP == mode) {
+                ++str;
+            } else {
+                x = 0;
+                ++y;
+            }
+            continue;
+        }
+
+        end = endOfSegment(lcd, x);
+        for (n = 0; str[n] && ('\n' != str[n]) && (x + n < end)
+                && (n < DDRAM_LINE_LENGTH); ++n) {
+            ch = str[n];
+            resetInvalidCharCodeToSafeDefault(&ch);
+            burst[n] = ch;
+        }
+        if (LCD_OPERATION_OK != (rs = putStretch(lcd, x, y, burst, n)))
+            break;
+        written += n;
+        x += n;
+        str += n;
+    }
+
+    if (lcd->shadowEnabled) {
+        lcd->cursorX = (y < lcd->screenHeight) ? x : lcd->screenWidth;
+        lcd->cursorY = (y < lcd->screenHeight) ? y : lcd->screenHeight - 1;
+    }
+
+out:
+    if (pWritten)
+        *pWritten = written;
+
+    return trackFault(lcd, rs);
+}
+
+void
+LCDDriver_InvalidateAddressCache(LCDDriver * lcd)
+{
+    forgetAddresses(lcd);
+}
+
+/*   For the application that has brought the controller back itself
+ * (e.g. re-initialized it); the next call goes to the bus at once.
+ */
+void
+LCDDriver_ClearFault(LCDDriver * lcd)
+{
+    lcd->faulted = 0;
+    forgetAddresses(lcd);
+}
+
+int32_t
+LCDDriver_EnableShadow(LCDDriver * lcd)
+{
+    int32_t rs;
+
+    if (LCD_OPERATION_OK == (rs = resetShadow(lcd)))
+        lcd->shadowEnabled = 1;
+
+    return rs;
+}
+
+/*   Warm restart: the shadow takes over what the display already shows
+ * (all cells clean), so nothing is redrawn.  Needs the RW line.
+ */
+int32_t
+LCDDriver_LoadShadow(LCDDriver * lcd)
+{
+    int16_t x, y;
+    int32_t idx, rs;
+
+    if (LCD_OPERATION_OK != (rs = resetShadow(lcd)))
+        return rs;
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
+
+    for (y = 0; y < lcd->screenHeight; ++y) {
+        selectControllerOfRow(lcd, y);
+        for (x = 0; x < lcd->screenWidth; ++x) {
+            // free unless a segment of the row starts here
+            rs = setDDRAMAddress(lcd, ddramAddress(lcd, x, y));
+            if (LCD_OPERATION_OK != rs)
+                goto out;
+            idx = y * lcd->screenWidth + x;
+            rs = readCell(lcd, &lcd->shadowCells[idx]);
+            if (LCD_OPERATION_OK != rs)
+                goto out;
+            markCellClean(lcd, idx);
+        }
+    }
+    lcd->shadowEnabled = 1;
+
+out:
+    return trackFault(lcd, rs);
+}
+
+void
+LCDDriver_DisableShadow(LCDDriver * lcd)
+{
+    lcd->shadowEnabled = 0;
+}
+
+int32_t
+LCDDriver_Flush(LCDDriver * lcd)
+{
+    int16_t x, y, runEnd;
+    int32_t rs = LCD_OPERATION_OK;
+
+    if (!lcd->shadowEnabled)
+        return LCD_OPERATION_OK;
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
+
+    if (lcd->geometry->controllers > 1)
+        return trackFault(lcd, flushSideBySide(lcd));
+
+    for (y = 0; y < lcd->screenHeight; ++y) {
+        for (x = 0; x < lcd->screenWidth; ++x) {
+            if (!isCellDirty(lcd, y * lcd->screenWidth + x))
+                continue;
+
+            runEnd = findEndOfDirtyRun(lcd, x, y);
+            rs = flushRun(lcd, x, runEnd, y);
+            if (LCD_OPERATION_OK != rs)
+                goto out;
+            x = runEnd;
+        }
+    }
+
+out:
+    return trackFault(lcd, rs);
+}
+
+/*   Marquee on row y: the text, followed by blanks a screen wide at
+ * least, goes round through the row one column per LCDDriver_StepMarquee().
+ * The row is a DDRAM line of 40 columns, of which the screen shows the
+ * first ones only: the text is loaded into the line once, and as it
+ * moves on, the columns that went out of sight on the left get what
+ * comes next, in a burst every few steps.  A step itself is a single
+ * display shift instruction.
+ *   The shift moves the whole display of the controller: its other row
+ * scrolls along, and GotoXY() loses track of the screen columns until
+ * the marquee stops.  Needs rows that are DDRAM lines of their own and
+ * narrower than 40 columns (16x2, 20x2, 24x2), and no shadow mode.
+ */
+int32_t
+LCDDriver_StartMarquee(LCDDriver * lcd, int16_t y, const int8_t * text)
+{
+    LCDDriverMarquee * m = &lcd->marquee;
+    int16_t x = 0, length;
+    int32_t rs;
+
+    if ((text == 0) || lcd->shadowEnabled || !rowsAreWholeLines(lcd))
+        return LCD_OPERATION_UNSUPPORTED;
+
+    resetInvalidValuesOfCoordinates(lcd, &x, &y);
+    for (length = 0; text[length] && (length < INT16_MAX); ++length)
+        ;
+
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
 
-    for (i = 0; str[i] && i < screenWidth; ++i)
-        rs = LCDDriver_Putc(str[i]);
+    m->text = 0;
+    selectControllerOfRow(lcd, y);
+    if (LCD_OPERATION_OK != (rs = homeDisplay(lcd)))
+        return trackFault(lcd, rs);
+
+    m->length = length;
+    m->row = y;
+    // a text that fits into the line along with its gap is loaded once
+    m->period = length + lcd->screenWidth;
+    if (m->period < DDRAM_LINE_LENGTH)
+        m->period = DDRAM_LINE_LENGTH;
+    m->window = 0;
+    m->loaded = 0;
+    m->text = text;
+
+    if (LCD_OPERATION_OK != (rs = refillMarquee(lcd, DDRAM_LINE_LENGTH)))
+        m->text = 0;
+
+    return trackFault(lcd, rs);
+}
+
+/*   The column about to come into sight on the right has to be in DDRAM
+ * before the shift.  After a failure the shift and the line are unknown:
+ * the marquee stops, and it takes a new start.
+ */
+int32_t
+LCDDriver_StepMarquee(LCDDriver * lcd)
+{
+    LCDDriverMarquee * m = &lcd->marquee;
+    int32_t rs;
+
+    if (m->text == 0)
+        return LCD_OPERATION_NOT_CONFIGURED;
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
+
+    selectControllerOfRow(lcd, m->row);
+    if ((m->period > DDRAM_LINE_LENGTH)
+            && (m->loaded <= m->window + lcd->screenWidth)) {
+        rs = refillMarquee(lcd, m->window + DDRAM_LINE_LENGTH);
+        if (LCD_OPERATION_OK != rs)
+            goto out;
+    }
+
+    LCDIntf_WriteInstruction(lcd->ctl->intf, DISPLAY_SHIFT__LEFT);
+    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(lcd->ctl->intf)))
+        goto out;
+
+    // after a whole number of rounds both the text and the line start over
+    if (++m->window == m->period * DDRAM_LINE_LENGTH) {
+        m->window = 0;
+        m->loaded -= m->period * DDRAM_LINE_LENGTH;
+    }
+
+out:
+    if (LCD_OPERATION_OK != rs)
+        m->text = 0;
+
+    return trackFault(lcd, rs);
+}
+
+/*   Shifts the display home; the row keeps what its line holds there. */
+int32_t
+LCDDriver_StopMarquee(LCDDriver * lcd)
+{
+    LCDDriverMarquee * m = &lcd->marquee;
+    int32_t rs;
+
+    if (m->text == 0)
+        return LCD_OPERATION_OK;
+    if (LCD_OPERATION_OK != (rs = checkFault(lcd)))
+        return rs;
+
+    m->text = 0;
+    selectControllerOfRow(lcd, m->row);
+
+    return trackFault(lcd, homeDisplay(lcd));
+}
+
+/* ==== Private Implementation ========================================== */
+
+/*   Once the back-off is over every controller has to answer a status
+ * read with a clear busy flag; without the RW line there is nothing to
+ * read and the pending operation itself is the probe.
+ */
+static int32_t
+checkFault(LCDDriver * lcd)
+{
+    int32_t status;
+    int8_t i;
+
+    if (!lcd->faulted)
+        return LCD_OPERATION_OK;
+
+    // wrap-safe "now < reprobeAt"
+    if ((int32_t)(Timestamp_microseconds() - lcd->reprobeAt) < 0)
+        return LCD_OPERATION_FAULT;
+
+    // the fault may be on any of the controllers
+    for (i = 0; i < lcd->controllerCount; ++i) {
+        status = LCDIntf_ReadInstruction(lcd->controllers[i].intf);
+        if ((status >= 0) && (status & READ_INSTRUCTION__BUSY_FLAG_MASK)) {
+            lcd->reprobeAt =
+                Timestamp_microseconds() + LCDDRIVER_FAULT_BACKOFF_US;
+            return LCD_OPERATION_FAULT;
+        }
+    }
+
+    lcd->faulted = 0;
+    forgetAddresses(lcd);
+
+    return LCD_OPERATION_OK;
+}
+
+static int32_t
+trackFault(LCDDriver * lcd, int32_t rs)
+{
+    if (LCD_OPERATION_TIMEOUT == rs) {
+        lcd->faulted = 1;
+        lcd->reprobeAt = Timestamp_microseconds() + LCDDRIVER_FAULT_BACKOFF_US;
+    }
+
+    return rs;
+}
+
+static int32_t
+resetShadow(LCDDriver * lcd)
+{
+    int32_t idx, cells = lcd->screenWidth * lcd->screenHeight;
+
+    if ((cells <= 0) || (cells > LCDDRIVER_SHADOW_CELLS))
+        return LCD_OPERATION_UNSUPPORTED;
+
+    // display contents are unknown, thus the first flush rewrites it all
+    for (idx = 0; idx < cells; ++idx) {
+        lcd->shadowCells[idx] = ' ';
+        markCellDirty(lcd, idx);
+    }
+    lcd->cursorX = lcd->cursorY = 0;
+
+    return LCD_OPERATION_OK;
+}
+
+static void
+markCellDirty(LCDDriver * lcd, int32_t idx)
+{
+    lcd->dirtyCells[idx >> 3] |= (uint8_t)(1u << (idx & 0x07));
+}
+
+static void
+markCellClean(LCDDriver * lcd, int32_t idx)
+{
+    lcd->dirtyCells[idx >> 3] &= (uint8_t)~(1u << (idx & 0x07));
+}
+
+static int32_t
+isCellDirty(LCDDriver * lcd, int32_t idx)
+{
+    return lcd->dirtyCells[idx >> 3] & (1u << (idx & 0x07));
+}
+
+static void
+putShadowCell(LCDDriver * lcd, int16_t x, int16_t y, int32_t ch)
+{
+    int32_t idx = y * lcd->screenWidth + x;
+
+    if (lcd->shadowCells[idx] == ch)
+        return;
+
+    lcd->shadowCells[idx] = ch;
+    markCellDirty(lcd, idx);
+}
+
+/*   A run starts at dirty cell (x, y) and swallows the following dirty
+ * cells as long as rewriting the clean cells in between is cheaper than
+ * a jump over them.  The address counter does not follow the cells into
+ * the next segment, neither does a run.  Returns the column of the last
+ * dirty cell of the run.
+ */
+static int16_t
+findEndOfDirtyRun(LCDDriver * lcd, int16_t x, int16_t y)
+{
+    int16_t next, runEnd = x, segmentEnd = endOfSegment(lcd, x);
+    int32_t rowStart = y * lcd->screenWidth;
+
+    for (next = x + 1; next < segmentEnd; ++next) {
+        if (!isCellDirty(lcd, rowStart + next))
+            continue;
+        if ((next - runEnd - 1) * LCDDRIVER_FLUSH_CELL_COST
+                >= LCDDRIVER_FLUSH_JUMP_COST)
+            break;
+        runEnd = next;
+    }
+
+    return runEnd;
+}
+
+/*   A run is a single burst; it stays dirty as a whole if the burst fails. */
+static int32_t
+flushRun(LCDDriver * lcd, int16_t x, int16_t runEnd, int16_t y)
+{
+    int32_t idx, rs;
+
+    rs = setDDRAMAddress(lcd, ddramAddress(lcd, x, y));
+    if (LCD_OPERATION_OK != rs)
+        return rs;
+
+    idx = y * lcd->screenWidth + x;
+    rs = writeCells(lcd, &lcd->shadowCells[idx], runEnd - x + 1);
+    if (LCD_OPERATION_OK != rs)
+        return rs;
+
+    for (; x <= runEnd; ++x, ++idx)
+        markCellClean(lcd, idx);
+
+    return LCD_OPERATION_OK;
+}
+
+static void
+selectControllerOfRow(LCDDriver * lcd, int16_t y)
+{
+    const LCDGeometry * g = lcd->geometry;
+
+    lcd->ctl = &lcd->controllers[(g->controllers > 1) ?
+        (y * g->controllers / g->rows) : 0];
+}
+
+static void
+forgetAddresses(LCDDriver * lcd)
+{
+    int8_t i;
+
+    for (i = 0; i < lcd->controllerCount; ++i)
+        lcd->controllers[i].ddramAddrCache = DDRAM_ADDR_UNKNOWN;
+}
+
+/*   The controllers take turns, a transfer each: while one executes its
+ * transfer, the other one is written to.  Every transfer waits for the
+ * previous one of its controller rather than for itself, so a busy wait
+ * covers the time the other controller was being written to.
+ */
+static int32_t
+flushSideBySide(LCDDriver * lcd)
+{
+    FlushCursor cursors[LCDDRIVER_MAX_CONTROLLERS];
+    int32_t rs;
+    int8_t i, pending;
+
+    for (i = 0; i < lcd->geometry->controllers; ++i)
+        startFlushCursor(lcd, &cursors[i], i);
+
+    do {
+        pending = 0;
+        for (i = 0; i < lcd->geometry->controllers; ++i) {
+            if (cursors[i].done)
+                continue;
+            rs = flushStep(lcd, &cursors[i]);
+            if (LCD_OPERATION_PENDING == rs)
+                pending = 1;
+            else if (LCD_OPERATION_OK == rs)
+                cursors[i].done = 1;
+            else
+                return rs;
+        }
+    } while (pending);
+
+    return LCD_OPERATION_OK;
+}
+
+static void
+startFlushCursor(LCDDriver * lcd, FlushCursor * fc, int8_t i)
+{
+    int16_t rowsPerController = lcd->screenHeight / lcd->geometry->controllers;
+
+    fc->ctl = &lcd->controllers[i];
+    fc->x = 0;
+    fc->y = i * rowsPerController;
+    fc->runEnd = -1;
+    fc->lastRow = fc->y + rowsPerController - 1;
+    fc->pendingIdx = -1;
+    fc->done = 0;
+}
+
+/*   Returns LCD_OPERATION_PENDING after a transfer, LCD_OPERATION_OK once
+ * the rows of the controller are clean.
+ */
+static int32_t
+flushStep(LCDDriver * lcd, FlushCursor * fc)
+{
+    LCDDriverController * ctl = fc->ctl;
+    uint32_t addr;
+    int32_t rs, idx;
+
+    if (LCD_OPERATION_OK != (rs = confirmFlushStep(lcd, fc)))
+        return rs;
+    if ((fc->x > fc->runEnd) && !findNextRun(lcd, fc))
+        return LCD_OPERATION_OK;
+
+    addr = ddramAddress(lcd, fc->x, fc->y);
+    if ((int32_t)addr != ctl->ddramAddrCache) {
+        LCDIntf_WriteInstruction(ctl->intf, SET_DDRAM_ADDRESS_CMD | addr);
+        ctl->ddramAddrCache = addr;
+        return LCD_OPERATION_PENDING;
+    }
+
+    idx = fc->y * lcd->screenWidth + fc->x;
+    LCDIntf_WriteData(ctl->intf, lcd->shadowCells[idx]);
+    ctl->ddramAddrCache = nextDDRAMAddress(addr);
+    fc->pendingIdx = idx;
+    ++fc->x;
+
+    return LCD_OPERATION_PENDING;
+}
+
+static int32_t
+confirmFlushStep(LCDDriver * lcd, FlushCursor * fc)
+{
+    int32_t rs;
+
+    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(fc->ctl->intf))) {
+        fc->ctl->ddramAddrCache = DDRAM_ADDR_UNKNOWN;
+        return rs;
+    }
+    if (fc->pendingIdx >= 0)
+        markCellClean(lcd, fc->pendingIdx);
+    fc->pendingIdx = -1;
+
+    return LCD_OPERATION_OK;
+}
+
+static int32_t
+findNextRun(LCDDriver * lcd, FlushCursor * fc)
+{
+    for (; fc->y <= fc->lastRow; ++fc->y, fc->x = 0) {
+        for (; fc->x < lcd->screenWidth; ++fc->x) {
+            if (isCellDirty(lcd, fc->y * lcd->screenWidth + fc->x)) {
+                fc->runEnd = findEndOfDirtyRun(lcd, fc->x, fc->y);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*   The column past the segment that column x is in. */
+static int16_t
+endOfSegment(LCDDriver * lcd, int16_t x)
+{
+    int16_t segmentWidth = lcd->geometry->segmentWidth;
+
+    return (x / segmentWidth + 1) * segmentWidth;
+}
+
+/*   Cells of a single segment of row y, from column x on. */
+static int32_t
+putStretch(LCDDriver * lcd, int16_t x, int16_t y, const uint8_t * cells,
+        int16_t n)
+{
+    int32_t rs;
+    int16_t i;
+
+    if (lcd->shadowEnabled) {
+        for (i = 0; i < n; ++i)
+            putShadowCell(lcd, x + i, y, cells[i]);
+        return LCD_OPERATION_OK;
+    }
+
+    selectControllerOfRow(lcd, y);
+    rs = setDDRAMAddress(lcd, ddramAddress(lcd, x, y));
+    if (LCD_OPERATION_OK != rs)
+        return rs;
+
+    return writeCells(lcd, cells, n);
+}
+
+/*   Every row starts a DDRAM line of its own, with columns of the line
+ * left out of sight.
+ */
+static int32_t
+rowsAreWholeLines(LCDDriver * lcd)
+{
+    const LCDGeometry * g = lcd->geometry;
+    int32_t cell;
+    int16_t y;
+    uint8_t base;
+
+    if ((g->columns >= DDRAM_LINE_LENGTH) || (g->segmentWidth < g->columns))
+        return 0;
+
+    for (y = 0; y < g->rows; ++y) {
+        cell = y * g->columns;
+        base = g->segmentBase[cell / g->segmentWidth];
+        if ((cell % g->segmentWidth)
+                || ((0 != base) && (DDRAM_2ND_LINE_ADDR != base)))
+            return 0;
+    }
+
+    return 1;
+}
+
+/*   Undoes the display shift; the address counter goes to 0 as well. */
+static int32_t
+homeDisplay(LCDDriver * lcd)
+{
+    LCDDriverController * ctl = lcd->ctl;
+    int32_t rs;
+
+    LCDIntf_WriteInstruction(ctl->intf, RETURN_HOME);
+
+    rs = LCDIntf_WaitWhileBusy(ctl->intf);
+    ctl->ddramAddrCache = (LCD_OPERATION_OK == rs) ? 0 : DDRAM_ADDR_UNKNOWN;
 
     return rs;
 }
 
+static int32_t
+marqueeChar(const LCDDriverMarquee * m, int32_t pos)
+{
+    int32_t ch;
+
+    pos %= m->period;
+    ch = (pos < m->length) ? m->text[pos] : ' ';
+    resetInvalidCharCodeToSafeDefault(&ch);
+
+    return ch;
+}
+
+/*   Loads the positions from loaded up to end; a position goes to column
+ * (position % 40) of the line, so a burst stops where the line wraps.
+ */
+static int32_t
+refillMarquee(LCDDriver * lcd, int32_t end)
+{
+    LCDDriverMarquee * m = &lcd->marquee;
+    uint8_t burst[DDRAM_LINE_LENGTH];
+    uint32_t base = ddramAddress(lcd, 0, m->row);
+    int32_t column, rs;
+    int16_t n;
+
+    while (m->loaded < end) {
+        column = m->loaded % DDRAM_LINE_LENGTH;
+        for (n = 0; (m->loaded + n < end)
+                && (column + n < DDRAM_LINE_LENGTH); ++n)
+            burst[n] = marqueeChar(m, m->loaded + n);
+
+        if (LCD_OPERATION_OK != (rs = setDDRAMAddress(lcd, base + column)))
+            return rs;
+        if (LCD_OPERATION_OK != (rs = writeCells(lcd, burst, n)))
+            return rs;
+        m->loaded += n;
+    }
+
+    return LCD_OPERATION_OK;
+}
@@ -30,11 +30,133 @@
 #define D_LCDDriver_h
 
 #include <stdint.h>
+#include "LCDIntf.h"
+#include "LCDGeometry.h"
 
-int32_t LCDDriver_Clear(void);
-void    LCDDriver_SetupScreenDimensions(int16_t width, int16_t height);
-int32_t LCDDriver_GotoXY(int16_t x, int16_t y);
-int32_t LCDDriver_Putc(int32_t ch);
-int32_t LCDDriver_Puts(int8_t * str);
+/*   Size of the RAM shadow of DDRAM (in cells).  A screen that does not
+ * fit into it cannot be driven in shadow mode.
+ */
+#ifndef LCDDRIVER_SHADOW_CELLS
+#define LCDDRIVER_SHADOW_CELLS 80
+#endif
+
+/*   Flush cost model (in bus cycles).  Rewriting a clean cell takes a data
+ * transfer and a readiness check; jumping over it with SET_DDRAM_ADDRESS
+ * takes an instruction transfer, a readiness check and two RS flips.  The
+ * flush rewrites gaps between dirty cells that are cheaper than a jump.
+ */
+#ifndef LCDDRIVER_FLUSH_CELL_COST
+#define LCDDRIVER_FLUSH_CELL_COST 2
+#endif
+#ifndef LCDDRIVER_FLUSH_JUMP_COST
+#define LCDDRIVER_FLUSH_JUMP_COST 3
+#endif
+
+/*   After a bus timeout the driver is faulted: calls that need the bus
+ * return LCD_OPERATION_FAULT at once, and only after this back-off a cheap
+ * presence check (a single busy flag read) is tried again.
+ */
+#ifndef LCDDRIVER_FAULT_BACKOFF_US
+#define LCDDRIVER_FAULT_BACKOFF_US 500000
+#endif
+
+/*   Modes of LCDDriver_PutText(): what becomes of a row that is full. */
+enum {
+    LCDDRIVER_TEXT_WRAP = 0,        // the text goes on in the next row
+    LCDDRIVER_TEXT_CLIP,            // the rest of the line is dropped
+};
+
+/*   A controller of the display, behind an interface instance of its own
+ * (i.e. behind its own E line), and a software copy of its address
+ * counter, so that moving the cursor to where it already is costs no bus
+ * cycles.
+ */
+typedef struct LCDDriverController {
+    LCDIntf * intf;
+    int32_t  ddramAddrCache;
+} LCDDriverController;
+
+enum {
+    LCDDRIVER_MAX_CONTROLLERS = 2,
+};
+
+/*   A text going round through a row by means of the display shift: the
+ * text and a blank gap after it make up a period that repeats itself.
+ * Positions count the text round from the start of the marquee; the one
+ * of the leftmost column is the window, the ones below loaded are in
+ * DDRAM already.
+ */
+typedef struct LCDDriverMarquee {
+    const int8_t * text;            // NULL: no marquee running
+    int16_t  length;
+    int16_t  row;
+    int32_t  period;
+    int32_t  window;
+    int32_t  loaded;
+} LCDDriverMarquee;
+
+/*   A driver instance, one per display, on top of its own interface
+ * instance.  The caller provides the storage; the fields are private to
+ * LCDDriver.
+ */
+typedef struct LCDDriver {
+    /*   40x4 modules hold two controllers on a common bus: the first one
+     * drives rows 0-1, the second one rows 2-3.  ctl is the controller
+     * of the row the cursor is on.
+     */
+    LCDDriverController controllers[LCDDRIVER_MAX_CONTROLLERS];
+    int8_t   controllerCount;
+    LCDDriverController * ctl;
+
+    /*   The screen size is the one of the geometry; the own geometry is
+     * the one LCDDriver_SetupScreenDimensions() builds.
+     */
+    const LCDGeometry * geometry;
+    LCDGeometry ownGeometry;
+    int16_t  screenWidth;
+    int16_t  screenHeight;
+
+    /*   Shadow mode: Putc/Puts/GotoXY/Clear only update a RAM copy of the
+     * screen and mark changed cells dirty; LCDDriver_Flush() pushes the
+     * dirty cells to the controller.
+     */
+    int8_t   shadowEnabled;
+    int16_t  cursorX;
+    int16_t  cursorY;
+    uint8_t  shadowCells[LCDDRIVER_SHADOW_CELLS];
+    uint8_t  dirtyCells[(LCDDRIVER_SHADOW_CELLS + 7) / 8];
+
+    /*   Fault state: set by a timeout, so that an unresponsive controller
+     * costs one busy wait per back-off period rather than one per call.
+     */
+    int8_t   faulted;
+    uint32_t reprobeAt;
+
+    LCDDriverMarquee marquee;
+} LCDDriver;
+
+void    LCDDriver_Init(LCDDriver * lcd, LCDIntf * intf);
+int32_t LCDDriver_AddController(LCDDriver * lcd, LCDIntf * intf);
+int32_t LCDDriver_Clear(LCDDriver * lcd);
+void    LCDDriver_SetupScreenDimensions(LCDDriver * lcd, int16_t width,
+        int16_t height);
+int32_t LCDDriver_SetupGeometry(LCDDriver * lcd, const LCDGeometry * geometry);
+int32_t LCDDriver_GotoXY(LCDDriver * lcd, int16_t x, int16_t y);
+int32_t LCDDriver_Putc(LCDDriver * lcd, int32_t ch);
+int32_t LCDDriver_Puts(LCDDriver * lcd, int8_t * str);
+int32_t LCDDriver_PutText(LCDDriver * lcd, int16_t x, int16_t y,
+        const int8_t * str, int32_t mode, int16_t * pWritten);
+void    LCDDriver_InvalidateAddressCache(LCDDriver * lcd);
+void    LCDDriver_ClearFault(LCDDriver * lcd);
+
+int32_t LCDDriver_EnableShadow(LCDDriver * lcd);
+int32_t LCDDriver_LoadShadow(LCDDriver * lcd);
+void    LCDDriver_DisableShadow(LCDDriver * lcd);
+int32_t LCDDriver_Flush(LCDDriver * lcd);
+
+int32_t LCDDriver_StartMarquee(LCDDriver * lcd, int16_t y,
+        const int8_t * text);
+int32_t LCDDriver_StepMarquee(LCDDriver * lcd);
+int32_t LCDDriver_StopMarquee(LCDDriver * lcd);
 
 #endif /* #ifndef D_LCDDriver_h */
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include "LCDGeometry.h"
+
+const LCDGeometry LCDGeometry_8x1  = {  8, 1, 1,  8, { 0x00 } };
+// one row of the 8x2 kind: its right half is DDRAM line 2
+const LCDGeometry LCDGeometry_16x1 = { 16, 1, 1,  8, { 0x00, 0x40 } };
+const LCDGeometry LCDGeometry_16x2 = { 16, 2, 1, 16, { 0x00, 0x40 } };
+const LCDGeometry LCDGeometry_16x4 = { 16, 4, 1, 16,
+    { 0x00, 0x40, 0x10, 0x50 } };
+const LCDGeometry LCDGeometry_20x2 = { 20, 2, 1, 20, { 0x00, 0x40 } };
+const LCDGeometry LCDGeometry_20x4 = { 20, 4, 1, 20,
+    { 0x00, 0x40, 0x14, 0x54 } };
+const LCDGeometry LCDGeometry_24x2 = { 24, 2, 1, 24, { 0x00, 0x40 } };
+const LCDGeometry LCDGeometry_40x2 = { 40, 2, 1, 40, { 0x00, 0x40 } };
+// two 40x2 controllers, one above the other
+const LCDGeometry LCDGeometry_40x4 = { 40, 4, 2, 40,
+    { 0x00, 0x40, 0x00, 0x40 } };
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_LCDGeometry_h
+#define D_LCDGeometry_h
+
+#include <stdint.h>
+
+/*   Layout of a display in DDRAM.  The cells are numbered row by row and
+ * cut into segments of segmentWidth cells, each starting at the DDRAM
+ * address of its segmentBase entry: a plain display has a segment per
+ * row, a 16x1 one of the 8x2 kind has two; columns is a multiple of
+ * segmentWidth.  With two controllers, the lower half of the rows belongs
+ * to the second one, at the addresses of that controller.
+ *   Descriptors are plain constant data: a display not listed below is
+ * described at compile time just as well.
+ */
+enum {
+    LCD_GEOMETRY_MAX_SEGMENTS = 4,
+};
+
+typedef struct LCDGeometry {
+    int16_t  columns;
+    int16_t  rows;
+    int8_t   controllers;
+    int16_t  segmentWidth;
+    uint8_t  segmentBase[LCD_GEOMETRY_MAX_SEGMENTS];
+} LCDGeometry;
+
+extern const LCDGeometry LCDGeometry_8x1;
+extern const LCDGeometry LCDGeometry_16x1;
+extern const LCDGeometry LCDGeometry_16x2;
+extern const LCDGeometry LCDGeometry_16x4;
+extern const LCDGeometry LCDGeometry_20x2;
+extern const LCDGeometry LCDGeometry_20x4;
+extern const LCDGeometry LCDGeometry_24x2;
+extern const LCDGeometry LCDGeometry_40x2;
+extern const LCDGeometry LCDGeometry_40x4;
+
+#endif /* #ifndef D_LCDGeometry_h */
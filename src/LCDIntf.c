@@ -28,400 +28,1351 @@
 
 #include <stdint.h>
 #include "LCDIntf.h"
-#include "LCDPort.h"
 
 #define HI_NIBBLE(byte) ((byte >> 4) & 0x0F)
 #define LO_NIBBLE(byte) (byte & 0x0F)
 
-static void writeInstruction_8BitIntf(int32_t instr);
-static void writeInstruction_4BitIntf(int32_t instr);
-static void writeData_8BitIntf(int32_t data);
-static void writeData_4BitIntf(int32_t data);
-static int32_t readInstruction_8BitIntf(void);
-static int32_t readInstruction_4BitIntf(void);
-static int32_t readData_8BitIntf(void);
-static int32_t readData_4BitIntf(void);
-static int32_t waitWhileBusy_8BitIntf(void);
-static int32_t waitWhileBusy_4BitIntf(void);
-static int32_t setup8BitMode(void);
-static int32_t setup4BitMode(void);
-static void select8BitInterfaceImplementation(void);
-static void select4BitInterfaceImplementation(void);
-
-typedef void (*pFvi_t)(int32_t);
-typedef int32_t (*pFiv_t)(void);
-
-static void stubFuncVI(int32_t x) {
-}
-static int32_t stubFuncIV(void) {
+/*   A port bound at build time is called directly, any other one through
+ * the table given to LCDIntf_Init().
+ */
+#if defined(LCD_INTF_PORT_HEADER)
+#include LCD_INTF_PORT_HEADER
+#define PORT_OP(op)     LCDPortInline_##op
+#else
+#define PORT_OP(op)     (intf->portOps->op)
+#endif
+
+/*   A port table tells at run time whether it has the whole bus cycles, a
+ * port bound at build time has them if built with LCD_PORT_BUS_CYCLES.
+ */
+#if !defined(LCD_INTF_PORT_HEADER) || defined(LCD_PORT_BUS_CYCLES)
+#define BUS_CYCLES_AVAILABLE
+#endif
+
+static inline void writeInstruction_8BitIntf(LCDIntf * intf, int32_t instr);
+static inline void writeInstruction_4BitIntf(LCDIntf * intf, int32_t instr);
+static inline void writeData_8BitIntf(LCDIntf * intf, int32_t data);
+static inline void writeData_4BitIntf(LCDIntf * intf, int32_t data);
+static inline int32_t readInstruction_8BitIntf(LCDIntf * intf);
+static inline int32_t readInstruction_4BitIntf(LCDIntf * intf);
+static inline int32_t readData_8BitIntf(LCDIntf * intf);
+static inline int32_t readData_4BitIntf(LCDIntf * intf);
+static inline int32_t waitWhileBusy_8BitIntf(LCDIntf * intf);
+static inline int32_t waitWhileBusy_4BitIntf(LCDIntf * intf);
+static int32_t runInitSequence(LCDIntf * intf);
+static int32_t writeInitStep(LCDIntf * intf, const LCDInitStep * step);
+static void writeInitNibble(LCDIntf * intf, int32_t nibble);
+static int32_t continueInit(LCDIntf * intf);
+static int32_t finishInit(LCDIntf * intf, int32_t status);
+static int32_t queueBurst(LCDIntf * intf, int32_t rs, const uint8_t * buf,
+        size_t n);
+static int32_t writeSignature(LCDIntf * intf);
+static int32_t signatureRow(int32_t row);
+#if defined(BUS_CYCLES_AVAILABLE)
+static inline int32_t portHasBusCycles(LCDIntf * intf);
+static inline void writeInstruction_BusCycles(LCDIntf * intf, int32_t instr);
+static inline void writeData_BusCycles(LCDIntf * intf, int32_t data);
+static inline void beginWrite_BusCycles(LCDIntf * intf, int32_t rs);
+static inline void putByte_BusCycles(LCDIntf * intf, int32_t b);
+static inline int32_t readInstruction_BusCycles(LCDIntf * intf);
+static inline int32_t readData_BusCycles(LCDIntf * intf);
+static inline int32_t waitWhileBusy_BusCycles(LCDIntf * intf);
+#endif
+static int32_t pollWhileBusy(LCDIntf * intf);
+static void waitUntilPredictedReady(LCDIntf * intf);
+static void predictReadiness(LCDIntf * intf, uint32_t executionTime);
+static uint32_t busyTimeoutOf(uint32_t executionTime);
+static int32_t isPastDeadline(uint32_t deadline);
+static void yieldWhileBusy(LCDIntf * intf);
+static uint32_t executionTimeOf(int32_t instr);
+static int32_t waitAfterInstruction(LCDIntf * intf, int32_t instr);
+static int32_t isRWLineWired(LCDIntf * intf);
+static void prepareWrite(LCDIntf * intf);
+static void driveDataLines8(LCDIntf * intf);
+static void driveDataLines4(LCDIntf * intf);
+static void releaseDataLines8(LCDIntf * intf);
+static void releaseDataLines4(LCDIntf * intf);
+static int32_t isBusDrivenByUs(LCDIntf * intf);
+static int32_t queueOperation(LCDIntf * intf, uint16_t op);
+static int32_t hasRoomInQueue(LCDIntf * intf, size_t n);
+static int32_t writePolledBurst(LCDIntf * intf, int32_t rs,
+        const uint8_t * buf, size_t n);
+static int32_t writeBurst(LCDIntf * intf, int32_t rs, const uint8_t * buf,
+        size_t n);
+static inline void beginWrite_8BitIntf(LCDIntf * intf, int32_t rs);
+static inline void beginWrite_4BitIntf(LCDIntf * intf, int32_t rs);
+static inline void putByte_8BitIntf(LCDIntf * intf, int32_t b);
+static inline void putByte_4BitIntf(LCDIntf * intf, int32_t b);
+static int32_t isControllerReady(LCDIntf * intf);
+
+#if defined(LCD_INTF_DATA_WIDTH)
+/*   The data width is fixed at build time: every operation is bound to its
+ * implementation directly, so nothing is dispatched at run time and the
+ * compiler is free to inline the bus sequences -- down to the port lines
+ * if the port is bound at build time as well.
+ */
+#if (8 == LCD_INTF_DATA_WIDTH)
+#define IMPLEMENTATION_OF(op)   op##_8BitIntf
+#elif (4 == LCD_INTF_DATA_WIDTH)
+#define IMPLEMENTATION_OF(op)   op##_4BitIntf
+#else
+#error "LCD_INTF_DATA_WIDTH has to be either 4 or 8"
+#endif
+#if defined(LCD_PORT_BUS_CYCLES)
+#undef IMPLEMENTATION_OF
+#define IMPLEMENTATION_OF(op)   op##_BusCycles
+#endif
+
+#define writeInstruction        IMPLEMENTATION_OF(writeInstruction)
+#define writeData               IMPLEMENTATION_OF(writeData)
+#define readInstruction         IMPLEMENTATION_OF(readInstruction)
+#define readData                IMPLEMENTATION_OF(readData)
+#define waitWhileBusy           IMPLEMENTATION_OF(waitWhileBusy)
+#define beginWrite              IMPLEMENTATION_OF(beginWrite)
+#define putByte                 IMPLEMENTATION_OF(putByte)
+#define initializeLCDController runInitSequence
+#else
+typedef void (*pFvi_t)(LCDIntf *, int32_t);
+typedef int32_t (*pFiv_t)(LCDIntf *);
+
+struct LCDIntfImpl {
+    pFvi_t writeInstruction;
+    pFvi_t writeData;
+    pFiv_t readInstruction;
+    pFiv_t readData;
+    pFiv_t waitWhileBusy;
+    pFiv_t initializeLCDController;
+    pFvi_t beginWrite;
+    pFvi_t putByte;
+};
+
+static void stubFuncVI(LCDIntf * intf, int32_t x) {
+}
+static int32_t stubFuncIV(LCDIntf * intf) {
     return -1;
 }
 
-static pFvi_t writeInstruction = stubFuncVI;
-static pFvi_t writeData = stubFuncVI;
-static pFiv_t readInstruction = stubFuncIV;
-static pFiv_t readData = stubFuncIV;
-static pFiv_t waitWhileBusy = stubFuncIV;
-static pFiv_t initializeLCDController = stubFuncIV;
-
-static int8_t lcdPortDataWidth = LCD_PORT_DATA_WIDTH_UNDEFINED;
+static const struct LCDIntfImpl noImplementation = {
+    stubFuncVI, stubFuncVI, stubFuncIV, stubFuncIV,
+    stubFuncIV, stubFuncIV, stubFuncVI, stubFuncVI
+};
+
+static const struct LCDIntfImpl implementation8Bit = {
+    writeInstruction_8BitIntf, writeData_8BitIntf,
+    readInstruction_8BitIntf, readData_8BitIntf,
+    waitWhileBusy_8BitIntf, runInitSequence,
+    beginWrite_8BitIntf, putByte_8BitIntf
+};
+
+static const struct LCDIntfImpl implementation4Bit = {
+    writeInstruction_4BitIntf, writeData_4BitIntf,
+    readInstruction_4BitIntf, readData_4BitIntf,
+    waitWhileBusy_4BitIntf, runInitSequence,
+    beginWrite_4BitIntf, putByte_4BitIntf
+};
+
+#if defined(BUS_CYCLES_AVAILABLE)
+/*   The port knows its data width, so a single set of routines serves both
+ * interfaces.  The controller initialization keeps its own sequences.
+ */
+static const struct LCDIntfImpl implementationBusCycles = {
+    writeInstruction_BusCycles, writeData_BusCycles,
+    readInstruction_BusCycles, readData_BusCycles,
+    waitWhileBusy_BusCycles, runInitSequence,
+    beginWrite_BusCycles, putByte_BusCycles
+};
+#endif
+
+/*   Every instance dispatches through the table picked by its data width,
+ * or by the whole bus cycles of its port.
+ */
+#define writeInstruction        (intf->impl->writeInstruction)
+#define writeData               (intf->impl->writeData)
+#define readInstruction         (intf->impl->readInstruction)
+#define readData                (intf->impl->readData)
+#define waitWhileBusy           (intf->impl->waitWhileBusy)
+#define initializeLCDController (intf->impl->initializeLCDController)
+#define beginWrite              (intf->impl->beginWrite)
+#define putByte                 (intf->impl->putByte)
+#endif /* #if defined(LCD_INTF_DATA_WIDTH) */
+
+/*   The data lines are turned around lazily: a write leaves them driven,
+ * so a burst of writes costs a single direction change, and only a read
+ * gives them back to the controller.
+ */
+enum {
+    BUS_RELEASED = 0,
+    BUS_DRIVEN
+};
+
+/*   Asynchronous engine: operations wait in a queue, LCDIntf_Poll() does
+ * one step of work per call -- either a single readiness check or a single
+ * transfer of a queued byte.
+ *   The queue is a lock-free SPSC ring, so the application may keep queueing
+ * while a timer ISR calls LCDIntf_Poll(); in that setup the blocking calls
+ * (which drain the queue themselves) must not be used.
+ */
+enum {
+    QUEUED_DATA_FLAG = 0x100,
+    QUEUED_BYTE_MASK = 0xFF,
+};
+
+/*   Controller initialization is a table of steps.  The default one sets
+ * the interface up as the datasheet suggests, with the shortest delays it
+ * allows; LCDIntf_SetInitSequence() may supply another one.
+ */
+enum {
+    INSTRUCTION_OPCODE_MASK = 0xE0,     // enough to tell FUNCTION SET
+    ADDRESS_COUNTER_MASK = 0x7F,
+    SIGNATURE_MASK = 0x1F,              // CGRAM keeps 5 bits for sure
+};
+
+static const uint16_t initDelays[] = {
+    0,                                  // LCD_INIT_DELAY_NONE
+    LCD_INIT_SETUP_DELAY_US,            // LCD_INIT_DELAY_SETUP
+    LCD_EXECUTION_TIME_SHORT_US,        // LCD_INIT_DELAY_SHORT
+    LCD_EXECUTION_TIME_LONG_US,         // LCD_INIT_DELAY_LONG
+};
+
+static const LCDInitStep defaultInitSequence[] = {
+    { FUNCTION_SET | FUNCTION_SET__8BIT,
+        LCD_INIT_STEP_4BIT_NIBBLE, LCD_INIT_DELAY_SETUP, 0 },
+    { LCD_INIT_FUNCTION_SET,
+        LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_SETUP, 0 },
+    { LCD_INIT_FUNCTION_SET,
+        LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_SHORT, 0 },
+    { LCD_INIT_DISPLAY_CONTROL,
+        LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_NONE, 1 },
+    { DISPLAY_CLEAR,
+        LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_NONE, 1 },
+    { LCD_INIT_ENTRY_MODE,
+        LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_NONE, 1 },
+};
 
 /* ==== Public Interface ================================================ */
 
+/*   The instance talks to the controller through the port operations,
+ * which get the port handle back on every call.
+ */
 int32_t
-LCDIntf_Init(int32_t dataWidth)
+LCDIntf_Init(LCDIntf * intf, const LCDPortOps * portOps, void * port,
+        int32_t dataWidth)
 {
-    lcdPortDataWidth = dataWidth;
+    intf->portOps = portOps;
+    intf->port = port;
+    intf->portDataWidth = LCD_PORT_DATA_WIDTH_UNDEFINED;
+    intf->busDirection = &intf->ownBusDirection;
+    *intf->busDirection = BUS_RELEASED;
+    intf->burstRS = LCD_PORT_RS_DATA;
+    intf->busyMode = LCD_BUSY_MODE_POLL;
+    intf->predictedReadyAt = 0;
+    intf->busyTimeout = LCD_BUSY_TIMEOUT_SHORT_US;
+    intf->yieldHook = NULL;
+    LCDRing_Init(&intf->opQueue, intf->opQueueStorage, LCD_INTF_QUEUE_SIZE);
+    intf->awaitingReadiness = 0;
+    intf->readinessDeadline = 0;
+    LCDIntf_SetInitSequence(intf, NULL, 0);
+    intf->initInProgress = 0;
+    intf->initAwaitingReadiness = 0;
+    intf->initStepIndex = 0;
+    intf->initStepReadyAt = 0;
+    intf->initStatus = LCD_OPERATION_OK;
+#if !defined(LCD_INTF_DATA_WIDTH)
+    intf->impl = &noImplementation;
+#else
+    intf->impl = NULL;
+    if (LCD_INTF_DATA_WIDTH != dataWidth)
+        return LCD_OPERATION_UNSUPPORTED;
+#endif
+    intf->portDataWidth = dataWidth;
+
+    PORT_OP(init)(intf->port, intf->portDataWidth);
+
+#if !defined(LCD_INTF_DATA_WIDTH)
+    if (LCD_PORT_DATA_WIDTH_8_BIT == intf->portDataWidth) {
+        intf->impl = &implementation8Bit;
+    } else if (LCD_PORT_DATA_WIDTH_4_BIT == intf->portDataWidth) {
+        intf->impl = &implementation4Bit;
+    }
+#if defined(BUS_CYCLES_AVAILABLE)
+    if ((LCD_PORT_DATA_WIDTH_UNDEFINED != intf->portDataWidth)
+            && portHasBusCycles(intf))
+        intf->impl = &implementationBusCycles;
+#endif
+#endif
+
+	return 0;
+}
 
-    LCDPort_Init(lcdPortDataWidth);
+void
+LCDIntf_Deinit(LCDIntf * intf)
+{
+    PORT_OP(deinit)(intf->port);
+
+    intf->portDataWidth = LCD_PORT_DATA_WIDTH_UNDEFINED;
+    intf->busyMode = LCD_BUSY_MODE_POLL;
+    LCDRing_Init(&intf->opQueue, intf->opQueueStorage, LCD_INTF_QUEUE_SIZE);
+    intf->awaitingReadiness = 0;
+    LCDIntf_SetInitSequence(intf, NULL, 0);
+    intf->yieldHook = NULL;
+    intf->initInProgress = 0;
+    intf->initStatus = LCD_OPERATION_OK;
+}
 
-    if (LCD_PORT_DATA_WIDTH_8_BIT == lcdPortDataWidth) {
-        select8BitInterfaceImplementation();
-    } else if (LCD_PORT_DATA_WIDTH_4_BIT == lcdPortDataWidth) {
-        select4BitInterfaceImplementation();
+int32_t
+LCDIntf_GetPortDataWidth(LCDIntf * intf)
+{
+    return intf->portDataWidth;
+}
+/*   The blocking calls below first let the asynchronous engine finish its
+ * queue, so that operations reach the controller in order.  During an
+ * asynchronous init the writes are queued instead, as long as they fit.
+ */
+void
+LCDIntf_WriteInstruction(LCDIntf * intf, int32_t instr)
+{
+    if (intf->initInProgress && hasRoomInQueue(intf, 1)) {
+        LCDIntf_QueueInstruction(intf, instr);
+        return;
     }
 
-	return 0;
+    LCDIntf_Drain(intf);
+    waitUntilPredictedReady(intf);
+    writeInstruction(intf, instr);
+    predictReadiness(intf, executionTimeOf(instr));
 }
 
 void
-LCDIntf_Deinit(void)
+LCDIntf_WriteData(LCDIntf * intf, int32_t data)
+{
+    if (intf->initInProgress && hasRoomInQueue(intf, 1)) {
+        LCDIntf_QueueData(intf, data);
+        return;
+    }
+
+    LCDIntf_Drain(intf);
+    waitUntilPredictedReady(intf);
+    writeData(intf, data);
+    predictReadiness(intf, LCD_EXECUTION_TIME_SHORT_US);
+}
+
+int32_t
+LCDIntf_ReadData(LCDIntf * intf)
+{
+    int32_t rs;
+
+    if (!isRWLineWired(intf))
+        return -1;
+
+    LCDIntf_Drain(intf);
+    waitUntilPredictedReady(intf);
+    rs = readData(intf);
+    predictReadiness(intf, LCD_EXECUTION_TIME_SHORT_US);
+
+    return rs;
+}
+
+int32_t
+LCDIntf_ReadInstruction(LCDIntf * intf)
 {
-    LCDPort_Deinit();
+    if (!isRWLineWired(intf))
+        return -1;
 
-    lcdPortDataWidth = LCD_PORT_DATA_WIDTH_UNDEFINED;
+    LCDIntf_Drain(intf);
+
+    return readInstruction(intf);
+}
+
+int32_t
+LCDIntf_WaitWhileBusy(LCDIntf * intf)
+{
+    int32_t rs;
+
+    if (intf->initInProgress)
+        return LCD_OPERATION_PENDING;
+
+    if (LCD_OPERATION_OK != (rs = LCDIntf_Drain(intf)))
+        return rs;
+
+    if (LCD_BUSY_MODE_POLL != intf->busyMode)
+        return LCD_OPERATION_OK;
+
+    return pollWhileBusy(intf);
+}
+
+/*   Bursts select the register and drive the bus once, then only clock the
+ * bytes out; readiness is waited for after every byte, so a burst ends
+ * like a write followed by LCDIntf_WaitWhileBusy().  The first failure
+ * stops the burst.
+ *   Polling the busy flag turns the bus around, thus in LCD_BUSY_MODE_POLL
+ * the setup is repeated per byte; the predicted busy modes gain the most.
+ */
+int32_t
+LCDIntf_WriteInstructionBurst(LCDIntf * intf, const uint8_t * buf, size_t n)
+{
+    return writeBurst(intf, LCD_PORT_RS_INSTRUCTION, buf, n);
+}
+
+int32_t
+LCDIntf_WriteDataBurst(LCDIntf * intf, const uint8_t * buf, size_t n)
+{
+    return writeBurst(intf, LCD_PORT_RS_DATA, buf, n);
+}
+
+int32_t
+LCDIntf_InitializeLCDController(LCDIntf * intf)
+{
+    intf->initInProgress = 0;
+    intf->initStatus = initializeLCDController(intf);
+
+    return intf->initStatus;
+}
+
+/*   Counts the power-on delay from now and returns at once; LCDIntf_Poll()
+ * (or any blocking call that drains the queue) carries the init on.
+ */
+int32_t
+LCDIntf_StartLCDControllerInit(LCDIntf * intf)
+{
+    if (LCD_PORT_DATA_WIDTH_UNDEFINED == intf->portDataWidth)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    intf->initInProgress = 1;
+    intf->initAwaitingReadiness = 0;
+    intf->initStepIndex = 0;
+    intf->initStepReadyAt = Timestamp_microseconds() + LCD_POWER_ON_DELAY_US;
+    intf->initStatus = LCD_OPERATION_PENDING;
+
+    return LCD_OPERATION_PENDING;
 }
 
+/*   LCD_OPERATION_PENDING while an asynchronous init is running, otherwise
+ * the outcome of the last init.
+ */
 int32_t
-LCDIntf_GetPortDataWidth(void)
+LCDIntf_GetInitStatus(LCDIntf * intf)
 {
-    return lcdPortDataWidth;
+    return intf->initStatus;
 }
+
+/*   A controller left configured by an earlier run answers with a clear
+ * busy flag and keeps every row of the signature.  The address counter is
+ * put back where it was, so the screen and the cursor stay as they are.
+ *   Needs the RW line; returns LCD_OPERATION_NOT_CONFIGURED if the
+ * controller has to be initialized.
+ */
+int32_t
+LCDIntf_ProbeLCDController(LCDIntf * intf)
+{
+    int32_t status, row, rs, matches = 1;
+
+    if (!isRWLineWired(intf)
+            || (LCD_PORT_DATA_WIDTH_UNDEFINED == intf->portDataWidth))
+        return LCD_OPERATION_UNSUPPORTED;
+
+    status = LCDIntf_ReadInstruction(intf);
+    if (status & READ_INSTRUCTION__BUSY_FLAG_MASK)
+        return LCD_OPERATION_NOT_CONFIGURED;
+
+    LCDIntf_WriteInstruction(intf,
+        SET_CGRAM_ADDRESS_CMD | LCD_SIGNATURE_CGRAM_ADDR);
+    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(intf)))
+        goto out;
+    // the first row that does not match settles it
+    for (row = 0; matches && (row < LCD_SIGNATURE_ROWS); ++row) {
+        matches = (LCDIntf_ReadData(intf) & SIGNATURE_MASK)
+            == signatureRow(row);
+        if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(intf)))
+            goto out;
+    }
+
+    LCDIntf_WriteInstruction(intf, SET_DDRAM_ADDRESS_CMD
+        | (status & ADDRESS_COUNTER_MASK));
+    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(intf)))
+        goto out;
+
+    if (!matches)
+        rs = LCD_OPERATION_NOT_CONFIGURED;
+
+out:
+    return rs;
+}
+
+/*   Warm restart: a configured controller is left alone (screen included)
+ * and LCD_OPERATION_RESUMED is returned; otherwise the controller is
+ * initialized and signed.
+ */
+int32_t
+LCDIntf_ResumeOrInitializeLCDController(LCDIntf * intf)
+{
+    int32_t rs;
+
+    if (LCD_OPERATION_OK == LCDIntf_ProbeLCDController(intf))
+        return LCD_OPERATION_RESUMED;
+
+    if (LCD_OPERATION_OK != (rs = LCDIntf_InitializeLCDController(intf)))
+        return rs;
+
+    return writeSignature(intf);
+}
+
+/*   Steps are used in place: the table has to outlive its use.  NULL brings
+ * the default sequence back.
+ */
 void
-LCDIntf_WriteInstruction(int32_t instr)
+LCDIntf_SetInitSequence(LCDIntf * intf, const LCDInitStep * steps, size_t n)
 {
-    writeInstruction(instr);
+    if (NULL == steps) {
+        intf->initSequence = defaultInitSequence;
+        intf->initSequenceLength =
+            sizeof(defaultInitSequence) / sizeof(defaultInitSequence[0]);
+    } else {
+        intf->initSequence = steps;
+        intf->initSequenceLength = n;
+    }
 }
 
+/*   Select LCD_BUSY_MODE_WRITE_ONLY right after LCDIntf_Init(): the data
+ * lines are turned to outputs here, once and for all.  The port init
+ * leaves RW high, and the writes take a driven bus for one with RW low,
+ * so RW goes low first (RS to a known level along with it).
+ */
 void
-LCDIntf_WriteData(int32_t data)
+LCDIntf_SetBusyMode(LCDIntf * intf, int32_t mode)
 {
-    writeData(data);
+    intf->busyMode = mode;
+    intf->predictedReadyAt = Timestamp_microseconds();
+
+    if (LCD_BUSY_MODE_WRITE_ONLY != intf->busyMode)
+        return;
+
+    PORT_OP(clearRS)(intf->port);
+    PORT_OP(clearRW)(intf->port);
+    if (LCD_PORT_DATA_WIDTH_8_BIT == intf->portDataWidth) {
+        PORT_OP(setDirection_Output8)(intf->port);
+    } else if (LCD_PORT_DATA_WIDTH_4_BIT == intf->portDataWidth) {
+        PORT_OP(setDirection_Output4)(intf->port);
+    }
+    *intf->busDirection = BUS_DRIVEN;
 }
 
 int32_t
-LCDIntf_ReadData(void)
+LCDIntf_GetBusyMode(LCDIntf * intf)
+{
+    return intf->busyMode;
+}
+
+/*   For displays on shared data and RS/RW lines (each with an E line of
+ * its own): the instance takes the bus direction from the one already on
+ * the bus, so a bus turned around by either of them is seen by both.
+ */
+void
+LCDIntf_ShareBus(LCDIntf * intf, LCDIntf * onTheBus)
+{
+    intf->busDirection = onTheBus->busDirection;
+}
+
+/*   For broadcasts: intf is not to be taken as ready before other is.
+ * The later of both predictions and the longer busy timeout are kept;
+ * a polled instance reads its busy flag anyway.
+ */
+void
+LCDIntf_AwaitReadinessOf(LCDIntf * intf, const LCDIntf * other)
+{
+    if (other->busyTimeout > intf->busyTimeout)
+        intf->busyTimeout = other->busyTimeout;
+
+    if ((LCD_BUSY_MODE_POLL == intf->busyMode)
+            || (LCD_BUSY_MODE_POLL == other->busyMode))
+        return;
+    // wrap-safe "other->predictedReadyAt > intf->predictedReadyAt"
+    if ((int32_t)(other->predictedReadyAt - intf->predictedReadyAt) > 0)
+        intf->predictedReadyAt = other->predictedReadyAt;
+}
+
+void
+LCDIntf_SetYieldHook(LCDIntf * intf, LCDYieldHook hook)
 {
-    return readData();
+    intf->yieldHook = hook;
 }
 
 int32_t
-LCDIntf_ReadInstruction(void)
+LCDIntf_QueueInstruction(LCDIntf * intf, int32_t instr)
 {
-    return readInstruction();
+    return queueOperation(intf, instr & QUEUED_BYTE_MASK);
 }
 
 int32_t
-LCDIntf_WaitWhileBusy(void)
+LCDIntf_QueueData(LCDIntf * intf, int32_t data)
 {
-    return (waitWhileBusy()) ? LCD_OPERATION_TIMEOUT : LCD_OPERATION_OK;
+    return queueOperation(intf, QUEUED_DATA_FLAG | (data & QUEUED_BYTE_MASK));
 }
 
+/*   Safe to be called from an ISR (the consumer side of the queue).
+ *   Returns LCD_OPERATION_PENDING while there is work left, and
+ * LCD_OPERATION_OK once the queue is empty and the controller is ready.
+ * LCD_OPERATION_TIMEOUT means the controller did not get ready in time;
+ * the engine proceeds with the next operation anyway.
+ */
 int32_t
-LCDIntf_InitializeLCDController(void)
+LCDIntf_Poll(LCDIntf * intf)
 {
-    return initializeLCDController();
+    uint16_t op;
+    int32_t expired;
+
+    if (intf->initInProgress)
+        return continueInit(intf);
+
+    if (intf->awaitingReadiness) {
+        expired = isPastDeadline(intf->readinessDeadline);
+        if (!isControllerReady(intf)) {
+            if (!expired)
+                return LCD_OPERATION_PENDING;
+            intf->awaitingReadiness = 0;
+            return LCD_OPERATION_TIMEOUT;
+        }
+        intf->awaitingReadiness = 0;
+        return (LCDRing_GetLength(&intf->opQueue)) ?
+            LCD_OPERATION_PENDING : LCD_OPERATION_OK;
+    }
+
+    if (LCD_RING_OK != LCDRing_Peek(&intf->opQueue, &op))
+        return LCD_OPERATION_OK;
+    LCDRing_Drop(&intf->opQueue);
+
+    if (op & QUEUED_DATA_FLAG) {
+        writeData(intf, op & QUEUED_BYTE_MASK);
+        predictReadiness(intf, LCD_EXECUTION_TIME_SHORT_US);
+    } else {
+        writeInstruction(intf, op);
+        predictReadiness(intf, executionTimeOf(op));
+    }
+    intf->awaitingReadiness = 1;
+    intf->readinessDeadline = Timestamp_microseconds() + intf->busyTimeout;
+
+    return LCD_OPERATION_PENDING;
+}
+
+uint32_t
+LCDIntf_GetQueueOverflows(LCDIntf * intf)
+{
+    return LCDRing_GetOverflows(&intf->opQueue);
+}
+
+uint32_t
+LCDIntf_GetQueueHighWatermark(LCDIntf * intf)
+{
+    return LCDRing_GetHighWatermark(&intf->opQueue);
+}
+
+/*   Blocks until everything queued has been executed. */
+int32_t
+LCDIntf_Drain(LCDIntf * intf)
+{
+    int32_t rs, status = LCD_OPERATION_OK;
+
+    while (LCD_OPERATION_OK != (rs = LCDIntf_Poll(intf))) {
+        if (LCD_OPERATION_TIMEOUT == rs)
+            status = rs;
+    }
+
+    return status;
 }
 
 /* ==== Private Implementation ========================================== */
 
+static int32_t
+pollWhileBusy(LCDIntf * intf)
+{
+    return (waitWhileBusy(intf)) ? LCD_OPERATION_TIMEOUT : LCD_OPERATION_OK;
+}
+
+/*   The prediction is trusted: once it has run out the controller is
+ * taken as ready without a busy flag read, which would turn the bus around.
+ */
+static void
+waitUntilPredictedReady(LCDIntf * intf)
+{
+    uint32_t remaining;
+
+    if (LCD_BUSY_MODE_POLL == intf->busyMode)
+        return;
+
+    // wrap-safe "now < predictedReadyAt"
+    remaining = intf->predictedReadyAt - Timestamp_microseconds();
+    if ((int32_t)remaining <= 0)
+        return;
+
+    if (intf->yieldHook) {
+        while (!isPastDeadline(intf->predictedReadyAt))
+            intf->yieldHook();
+    } else {
+        Delay_microseconds(remaining);
+    }
+}
+
+/*   Called after every transfer; also picks the busy timeout budget. */
+static void
+predictReadiness(LCDIntf * intf, uint32_t executionTime)
+{
+    intf->busyTimeout = busyTimeoutOf(executionTime);
+
+    if (LCD_BUSY_MODE_POLL != intf->busyMode)
+        intf->predictedReadyAt = Timestamp_microseconds() + executionTime;
+}
+
+static uint32_t
+busyTimeoutOf(uint32_t executionTime)
+{
+    return (executionTime > LCD_EXECUTION_TIME_SHORT_US) ?
+        LCD_BUSY_TIMEOUT_LONG_US : LCD_BUSY_TIMEOUT_SHORT_US;
+}
+
+static int32_t
+isPastDeadline(uint32_t deadline)
+{
+    return (int32_t)(Timestamp_microseconds() - deadline) >= 0;
+}
+
 static void
-select8BitInterfaceImplementation(void)
+yieldWhileBusy(LCDIntf * intf)
+{
+    if (intf->yieldHook)
+        intf->yieldHook();
+}
+
+/*   Execution time of an instruction is picked by its opcode, i.e. by the
+ * most significant bit set.
+ */
+static const uint16_t instructionExecutionTimes[8] = {
+    LCD_EXECUTION_TIME_LONG_US,     // 0x01 clear display
+    LCD_EXECUTION_TIME_LONG_US,     // 0x02 return home
+    LCD_EXECUTION_TIME_SHORT_US,    // 0x04 entry mode set
+    LCD_EXECUTION_TIME_SHORT_US,    // 0x08 display on/off control
+    LCD_EXECUTION_TIME_SHORT_US,    // 0x10 cursor or display shift
+    LCD_EXECUTION_TIME_SHORT_US,    // 0x20 function set
+    LCD_EXECUTION_TIME_SHORT_US,    // 0x40 set CGRAM address
+    LCD_EXECUTION_TIME_SHORT_US,    // 0x80 set DDRAM address
+};
+
+static uint32_t
+executionTimeOf(int32_t instr)
+{
+    int32_t opcode;
+
+    for (opcode = 7; (opcode > 0) && !(instr & (1 << opcode)); --opcode)
+        ;
+
+    return instructionExecutionTimes[opcode];
+}
+
+/*   Used by controller initialization, which can't defer its waits. */
+static int32_t
+waitAfterInstruction(LCDIntf * intf, int32_t instr)
+{
+    if (isRWLineWired(intf))
+        return pollWhileBusy(intf);
+
+    Delay_microseconds(executionTimeOf(instr));
+
+    return LCD_OPERATION_OK;
+}
+
+static int32_t
+writeBurst(LCDIntf * intf, int32_t rs, const uint8_t * buf, size_t n)
+{
+    int32_t status;
+    size_t i;
+
+    if (intf->initInProgress
+            && (LCD_OPERATION_OK == (status = queueBurst(intf, rs, buf, n))))
+        return status;
+
+    if (LCD_OPERATION_OK != (status = LCDIntf_Drain(intf)))
+        return status;
+
+    if (0 == n)
+        return LCD_OPERATION_OK;
+    if (LCD_BUSY_MODE_POLL == intf->busyMode)
+        return writePolledBurst(intf, rs, buf, n);
+
+    // nothing is read in between, so the bus stays set up for the burst
+    beginWrite(intf, rs);
+    for (i = 0; i < n; ++i) {
+        waitUntilPredictedReady(intf);
+        putByte(intf, buf[i]);
+        predictReadiness(intf, (LCD_PORT_RS_DATA == rs) ?
+            LCD_EXECUTION_TIME_SHORT_US : executionTimeOf(buf[i]));
+    }
+
+    return LCD_OPERATION_OK;
+}
+
+/*   Every busy flag read releases the bus and selects the instruction
+ * register, hence the setup per byte.
+ */
+static int32_t
+writePolledBurst(LCDIntf * intf, int32_t rs, const uint8_t * buf, size_t n)
+{
+    int32_t status = LCD_OPERATION_OK;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        beginWrite(intf, rs);
+        putByte(intf, buf[i]);
+        predictReadiness(intf, (LCD_PORT_RS_DATA == rs) ?
+            LCD_EXECUTION_TIME_SHORT_US : executionTimeOf(buf[i]));
+
+        if (LCD_OPERATION_OK != (status = pollWhileBusy(intf)))
+            break;
+    }
+
+    return status;
+}
+
+/*   A burst written while the init is running waits in the queue, if it
+ * fits there as a whole; nothing is queued otherwise.
+ */
+static int32_t
+queueBurst(LCDIntf * intf, int32_t rs, const uint8_t * buf, size_t n)
+{
+    uint16_t flag = (LCD_PORT_RS_DATA == rs) ? QUEUED_DATA_FLAG : 0;
+    size_t i;
+
+    if (!hasRoomInQueue(intf, n))
+        return LCD_OPERATION_QUEUE_FULL;
+
+    for (i = 0; i < n; ++i)
+        queueOperation(intf, flag | buf[i]);
+
+    return LCD_OPERATION_OK;
+}
+
+/*   Asked by the producer side only, so the room can only grow meanwhile. */
+static int32_t
+hasRoomInQueue(LCDIntf * intf, size_t n)
 {
-    writeInstruction = writeInstruction_8BitIntf;
-    writeData = writeData_8BitIntf;
-    readInstruction = readInstruction_8BitIntf;
-    readData = readData_8BitIntf;
-    waitWhileBusy = waitWhileBusy_8BitIntf;
-    initializeLCDController = setup8BitMode;
+    return n <= LCD_INTF_QUEUE_SIZE - LCDRing_GetLength(&intf->opQueue);
+}
+
+static int32_t
+queueOperation(LCDIntf * intf, uint16_t op)
+{
+    if (LCD_RING_OK != LCDRing_Put(&intf->opQueue, op))
+        return LCD_OPERATION_QUEUE_FULL;
+
+    return LCD_OPERATION_OK;
+}
+
+/*   A single readiness check: one busy flag read when polling, a glance at
+ * the clock when the readiness is predicted.
+ */
+static int32_t
+isControllerReady(LCDIntf * intf)
+{
+    if (LCD_BUSY_MODE_POLL == intf->busyMode)
+        return !(readInstruction(intf) & READ_INSTRUCTION__BUSY_FLAG_MASK);
+
+    return (int32_t)(Timestamp_microseconds() - intf->predictedReadyAt) >= 0;
+}
+
+static int32_t
+isRWLineWired(LCDIntf * intf)
+{
+    return LCD_BUSY_MODE_WRITE_ONLY != intf->busyMode;
+}
+
+/*   With RW tied low the bus is marked driven for good by
+ * LCDIntf_SetBusyMode(), so the helpers below never touch RW nor the data
+ * lines direction.
+ */
+static int32_t
+isBusDrivenByUs(LCDIntf * intf)
+{
+    return BUS_DRIVEN == *intf->busDirection;
 }
 
 static void
-select4BitInterfaceImplementation(void)
+prepareWrite(LCDIntf * intf)
 {
-    writeInstruction = writeInstruction_4BitIntf;
-    writeData = writeData_4BitIntf;
-    readInstruction = readInstruction_4BitIntf;
-    readData = readData_4BitIntf;
-    waitWhileBusy = waitWhileBusy_4BitIntf;
-    initializeLCDController = setup4BitMode;
+    if (!isBusDrivenByUs(intf))
+        PORT_OP(clearRW)(intf->port);
 }
 
 static void
-writeInstruction_8BitIntf(int32_t instr)
+driveDataLines8(LCDIntf * intf)
 {
-    LCDPort_ClearRS();
-    LCDPort_ClearRW();
-    LCDPort_SetCE();
-    LCDPort_Out8(instr);
-    LCDPort_SetDirection_Output8();
-    LCDPort_ClearCE();
-    LCDPort_SetDirection_Input8();
-    LCDPort_SetRW();
+    if (isBusDrivenByUs(intf))
+        return;
+
+    PORT_OP(setDirection_Output8)(intf->port);
+    *intf->busDirection = BUS_DRIVEN;
 }
 
 static void
-writeInstruction_4BitIntf(int32_t instr)
+driveDataLines4(LCDIntf * intf)
 {
-    LCDPort_ClearRS();
-    LCDPort_ClearRW();
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(instr) );
-    LCDPort_SetDirection_Output4();
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_Out4( LO_NIBBLE(instr) );
-    LCDPort_ClearCE();
-    LCDPort_SetDirection_Input4();
-    LCDPort_SetRW();
+    if (isBusDrivenByUs(intf))
+        return;
+
+    PORT_OP(setDirection_Output4)(intf->port);
+    *intf->busDirection = BUS_DRIVEN;
 }
 
+/*   Called ahead of every read; the read sequences raise RW themselves. */
 static void
-writeData_8BitIntf(int32_t data)
+releaseDataLines8(LCDIntf * intf)
 {
-    LCDPort_SetRS();
-    LCDPort_ClearRW();
-    LCDPort_SetCE();
-    LCDPort_Out8(data);
-    LCDPort_SetDirection_Output8();
-    LCDPort_ClearCE();
-    LCDPort_SetDirection_Input8();
-    LCDPort_SetRW();
+    if (!isBusDrivenByUs(intf))
+        return;
+
+    PORT_OP(setDirection_Input8)(intf->port);
+    *intf->busDirection = BUS_RELEASED;
 }
+
 static void
-writeData_4BitIntf(int32_t data)
+releaseDataLines4(LCDIntf * intf)
+{
+    if (!isBusDrivenByUs(intf))
+        return;
+
+    PORT_OP(setDirection_Input4)(intf->port);
+    *intf->busDirection = BUS_RELEASED;
+}
+
+#if defined(BUS_CYCLES_AVAILABLE)
+static inline int32_t
+portHasBusCycles(LCDIntf * intf)
 {
-    LCDPort_SetRS();
-    LCDPort_ClearRW();
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(data) );
-    LCDPort_SetDirection_Output4();
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_Out4( LO_NIBBLE(data) );
-    LCDPort_ClearCE();
-    LCDPort_SetDirection_Input4();
-    LCDPort_SetRW();
+#if defined(LCD_INTF_PORT_HEADER)
+    return 1;
+#else
+    return (NULL != intf->portOps->writeByte)
+        && (NULL != intf->portOps->readByte);
+#endif
 }
 
-static int32_t
-readData_8BitIntf(void)
+/*   The bus cycles turn the data lines around themselves; the direction
+ * is noted all the same, for the line level routines of the init and for
+ * the other instances on a shared bus.
+ */
+static inline void
+writeInstruction_BusCycles(LCDIntf * intf, int32_t instr)
+{
+    PORT_OP(writeByte)(intf->port, LCD_PORT_RS_INSTRUCTION, instr);
+    *intf->busDirection = BUS_DRIVEN;
+}
+
+static inline void
+writeData_BusCycles(LCDIntf * intf, int32_t data)
+{
+    PORT_OP(writeByte)(intf->port, LCD_PORT_RS_DATA, data);
+    *intf->busDirection = BUS_DRIVEN;
+}
+
+static inline void
+beginWrite_BusCycles(LCDIntf * intf, int32_t rs)
+{
+    intf->burstRS = rs;
+}
+
+static inline void
+putByte_BusCycles(LCDIntf * intf, int32_t b)
+{
+    PORT_OP(writeByte)(intf->port, intf->burstRS, b);
+    *intf->busDirection = BUS_DRIVEN;
+}
+
+static inline int32_t
+readInstruction_BusCycles(LCDIntf * intf)
+{
+    *intf->busDirection = BUS_RELEASED;
+    return PORT_OP(readByte)(intf->port, LCD_PORT_RS_INSTRUCTION);
+}
+
+static inline int32_t
+readData_BusCycles(LCDIntf * intf)
+{
+    *intf->busDirection = BUS_RELEASED;
+    return PORT_OP(readByte)(intf->port, LCD_PORT_RS_DATA);
+}
+
+static inline int32_t
+waitWhileBusy_BusCycles(LCDIntf * intf)
+{
+    int32_t rs, expired;
+    uint32_t deadline = Timestamp_microseconds() + intf->busyTimeout;
+
+    *intf->busDirection = BUS_RELEASED;
+    // the clock is looked at ahead of the flag: a thread preempted past
+    // the deadline still gets a fresh read before giving up
+    for (;;) {
+        expired = isPastDeadline(deadline);
+        rs = PORT_OP(readByte)(intf->port, LCD_PORT_RS_INSTRUCTION)
+            & READ_INSTRUCTION__BUSY_FLAG_MASK;
+        if (!rs || expired)
+            break;
+        yieldWhileBusy(intf);
+    }
+
+    return rs;
+}
+#endif /* #if defined(BUS_CYCLES_AVAILABLE) */
+
+static inline void
+writeInstruction_8BitIntf(LCDIntf * intf, int32_t instr)
+{
+    PORT_OP(clearRS)(intf->port);
+    prepareWrite(intf);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out8)(intf->port, instr);
+    driveDataLines8(intf);
+    PORT_OP(clearCE)(intf->port);
+}
+
+static inline void
+writeInstruction_4BitIntf(LCDIntf * intf, int32_t instr)
+{
+    PORT_OP(clearRS)(intf->port);
+    prepareWrite(intf);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out4)(intf->port,  HI_NIBBLE(instr) );
+    driveDataLines4(intf);
+    PORT_OP(clearCE)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out4)(intf->port,  LO_NIBBLE(instr) );
+    PORT_OP(clearCE)(intf->port);
+}
+
+static inline void
+writeData_8BitIntf(LCDIntf * intf, int32_t data)
+{
+    PORT_OP(setRS)(intf->port);
+    prepareWrite(intf);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out8)(intf->port, data);
+    driveDataLines8(intf);
+    PORT_OP(clearCE)(intf->port);
+}
+static inline void
+writeData_4BitIntf(LCDIntf * intf, int32_t data)
+{
+    PORT_OP(setRS)(intf->port);
+    prepareWrite(intf);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out4)(intf->port,  HI_NIBBLE(data) );
+    driveDataLines4(intf);
+    PORT_OP(clearCE)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out4)(intf->port,  LO_NIBBLE(data) );
+    PORT_OP(clearCE)(intf->port);
+}
+
+static inline void
+beginWrite_8BitIntf(LCDIntf * intf, int32_t rs)
+{
+    if (LCD_PORT_RS_DATA == rs)
+        PORT_OP(setRS)(intf->port);
+    else
+        PORT_OP(clearRS)(intf->port);
+    prepareWrite(intf);
+    driveDataLines8(intf);
+}
+
+static inline void
+beginWrite_4BitIntf(LCDIntf * intf, int32_t rs)
+{
+    if (LCD_PORT_RS_DATA == rs)
+        PORT_OP(setRS)(intf->port);
+    else
+        PORT_OP(clearRS)(intf->port);
+    prepareWrite(intf);
+    driveDataLines4(intf);
+}
+
+static inline void
+putByte_8BitIntf(LCDIntf * intf, int32_t b)
+{
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out8)(intf->port, b);
+    PORT_OP(clearCE)(intf->port);
+}
+
+static inline void
+putByte_4BitIntf(LCDIntf * intf, int32_t b)
+{
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out4)(intf->port,  HI_NIBBLE(b) );
+    PORT_OP(clearCE)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out4)(intf->port,  LO_NIBBLE(b) );
+    PORT_OP(clearCE)(intf->port);
+}
+
+static inline int32_t
+readData_8BitIntf(LCDIntf * intf)
 {
     int32_t rs;
 
-    LCDPort_SetRS();
-    LCDPort_SetRW();
-    LCDPort_SetCE();
-    rs = LCDPort_In8();
-    LCDPort_ClearCE();
+    releaseDataLines8(intf);
+    PORT_OP(setRS)(intf->port);
+    PORT_OP(setRW)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    rs = PORT_OP(in8)(intf->port);
+    PORT_OP(clearCE)(intf->port);
 
     return rs;
 }
 
-static int32_t
-readData_4BitIntf(void)
+static inline int32_t
+readData_4BitIntf(LCDIntf * intf)
 {
     int32_t rs;
 
-    LCDPort_SetRS();
-    LCDPort_SetRW();
-    LCDPort_SetCE();
-    rs =  LO_NIBBLE( LCDPort_In4() ) << 4;
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    rs |= LO_NIBBLE( LCDPort_In4() );
-    LCDPort_ClearCE();
+    releaseDataLines4(intf);
+    PORT_OP(setRS)(intf->port);
+    PORT_OP(setRW)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    rs =  LO_NIBBLE( PORT_OP(in4)(intf->port) ) << 4;
+    PORT_OP(clearCE)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    rs |= LO_NIBBLE( PORT_OP(in4)(intf->port) );
+    PORT_OP(clearCE)(intf->port);
 
     return rs;
 }
 
-static int32_t
-readInstruction_8BitIntf(void)
+static inline int32_t
+readInstruction_8BitIntf(LCDIntf * intf)
 {
     int rs;
 
-    LCDPort_ClearRS();
-    LCDPort_SetRW();
-    LCDPort_SetCE();
-    rs = LCDPort_In8();
-    LCDPort_ClearCE();
+    releaseDataLines8(intf);
+    PORT_OP(clearRS)(intf->port);
+    PORT_OP(setRW)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    rs = PORT_OP(in8)(intf->port);
+    PORT_OP(clearCE)(intf->port);
 
     return rs;
 }
 
-static int32_t
-readInstruction_4BitIntf(void)
+static inline int32_t
+readInstruction_4BitIntf(LCDIntf * intf)
 {
     int rs;
 
-    LCDPort_ClearRS();
-    LCDPort_SetRW();
-    LCDPort_SetCE();
-    rs =  LO_NIBBLE( LCDPort_In4() ) << 4;
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    rs |= LO_NIBBLE( LCDPort_In4() );
-    LCDPort_ClearCE();
+    releaseDataLines4(intf);
+    PORT_OP(clearRS)(intf->port);
+    PORT_OP(setRW)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    rs =  LO_NIBBLE( PORT_OP(in4)(intf->port) ) << 4;
+    PORT_OP(clearCE)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    rs |= LO_NIBBLE( PORT_OP(in4)(intf->port) );
+    PORT_OP(clearCE)(intf->port);
 
     return rs;
 }
 
-#define WRITE_8BIT_INSTRUCTION_SEQUENCE(cmd)                                \
-    do {                                                                    \
-        LCDPort_ClearRS();                                                  \
-        LCDPort_ClearRW();                                                  \
-        LCDPort_SetCE();                                                    \
-        LCDPort_Out8( (cmd) );                                              \
-        LCDPort_SetDirection_Output8();                                     \
-        LCDPort_ClearCE();                                                  \
-        LCDPort_SetDirection_Input8();                                      \
-        LCDPort_SetRW();                                                    \
-    } while (0)
-
+/*   Runs the initialization table. */
 static int32_t
-setup8BitMode(void)
+runInitSequence(LCDIntf * intf)
 {
-    int32_t rs;
+    const LCDInitStep * step;
+    int32_t instr, rs = LCD_OPERATION_OK;
+    size_t i;
+
+    for (i = 0; i < intf->initSequenceLength; ++i) {
+        step = &intf->initSequence[i];
+        if ((instr = writeInitStep(intf, step)) < 0)
+            continue;
+
+        if (LCD_INIT_DELAY_NONE != step->delay)
+            Delay_microseconds(initDelays[step->delay]);
+        if (step->busyCheck) {
+            if (LCD_OPERATION_OK != (rs = waitAfterInstruction(intf, instr)))
+                break;
+        }
+    }
 
-    WRITE_8BIT_INSTRUCTION_SEQUENCE(FUNCTION_SET__8BIT_2LINE_8x11FONT);
-    Delay_microseconds(39);
+    return rs;
+}
 
-    WRITE_8BIT_INSTRUCTION_SEQUENCE(FUNCTION_SET__8BIT_2LINE_8x11FONT);
-    Delay_microseconds(37);
+/*   Returns the instruction written, or -1 for a step the bus skips.
+ * FUNCTION SET instructions get the interface width bit of the bus in use,
+ * so one table serves both widths.
+ */
+static int32_t
+writeInitStep(LCDIntf * intf, const LCDInitStep * step)
+{
+    int32_t instr = step->value;
+
+    if (LCD_INIT_STEP_4BIT_NIBBLE == step->mode) {
+        if (LCD_PORT_DATA_WIDTH_4_BIT != intf->portDataWidth)
+            return -1;
+        writeInitNibble(intf, HI_NIBBLE(instr));
+        intf->busyTimeout = LCD_BUSY_TIMEOUT_SHORT_US;
+        return instr;
+    }
 
-    WRITE_8BIT_INSTRUCTION_SEQUENCE(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
-    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy()))
-        goto out;
+    if (FUNCTION_SET == (instr & INSTRUCTION_OPCODE_MASK)) {
+        instr &= ~FUNCTION_SET__8BIT;
+        if (LCD_PORT_DATA_WIDTH_8_BIT == intf->portDataWidth)
+            instr |= FUNCTION_SET__8BIT;
+    }
+    writeInstruction(intf, instr);
+    intf->busyTimeout = busyTimeoutOf(executionTimeOf(instr));
 
-    WRITE_8BIT_INSTRUCTION_SEQUENCE(DISPLAY_CLEAR);
-    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy()))
-        goto out;
+    return instr;
+}
 
-    WRITE_8BIT_INSTRUCTION_SEQUENCE(ENTRY_MODE_SET__I_D_SH);
-    rs = LCDIntf_WaitWhileBusy();
+/*   One step of the asynchronous init per call: either a check of a
+ * deadline or of the busy flag, or the transfer of the next step.
+ */
+static int32_t
+continueInit(LCDIntf * intf)
+{
+    const LCDInitStep * step;
+    int32_t instr;
+    uint32_t now = Timestamp_microseconds();
+
+    if ((int32_t)(now - intf->initStepReadyAt) < 0)
+        return LCD_OPERATION_PENDING;
+
+    if (intf->initAwaitingReadiness) {
+        if (readInstruction(intf) & READ_INSTRUCTION__BUSY_FLAG_MASK) {
+            if ((int32_t)(now - intf->readinessDeadline) < 0)
+                return LCD_OPERATION_PENDING;
+            return finishInit(intf, LCD_OPERATION_TIMEOUT);
+        }
+        intf->initAwaitingReadiness = 0;
+    }
 
-out:
-    return rs;
+    do {
+        if (intf->initStepIndex >= intf->initSequenceLength)
+            return finishInit(intf, LCD_OPERATION_OK);
+        step = &intf->initSequence[intf->initStepIndex++];
+    } while ((instr = writeInitStep(intf, step)) < 0);
+
+    intf->initStepReadyAt = Timestamp_microseconds() + initDelays[step->delay];
+    if (step->busyCheck) {
+        if (isRWLineWired(intf)) {
+            intf->initAwaitingReadiness = 1;
+            intf->readinessDeadline =
+                intf->initStepReadyAt + intf->busyTimeout;
+        } else {
+            intf->initStepReadyAt += executionTimeOf(instr);
+        }
+    }
+
+    return LCD_OPERATION_PENDING;
 }
 
+/*   Operations queued during the init are served from now on, even if the
+ * init failed, like the queue does after a timeout.
+ */
 static int32_t
-setup4BitMode(void)
-{
-    int32_t rs = LCD_OPERATION_OK;
-
-    LCDPort_ClearRS();
-    LCDPort_ClearRW();
-
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(FUNCTION_SET__8BIT_2LINE_8x11FONT) );
-    LCDPort_SetDirection_Output4();
-    LCDPort_ClearCE();
-    Delay_microseconds(39);
-
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(FUNCTION_SET__4BIT_2LINE_8x11FONT) );
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_Out4( LO_NIBBLE(FUNCTION_SET__4BIT_2LINE_8x11FONT) );
-    LCDPort_ClearCE();
-    Delay_microseconds(39);
-
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(FUNCTION_SET__4BIT_2LINE_8x11FONT) );
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_Out4( LO_NIBBLE(FUNCTION_SET__4BIT_2LINE_8x11FONT) );
-    LCDPort_ClearCE();
-    Delay_microseconds(37);
-
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF) );
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_Out4( LO_NIBBLE(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF) );
-    LCDPort_ClearCE();
-    LCDPort_SetDirection_Input4();
-    LCDPort_SetRW();
-
-    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy()))
-        goto out;
+finishInit(LCDIntf * intf, int32_t status)
+{
+    intf->initInProgress = 0;
+    intf->initAwaitingReadiness = 0;
+    intf->initStatus = status;
 
-    LCDPort_ClearRW();
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(DISPLAY_CLEAR) );
-    LCDPort_SetDirection_Output4();
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_Out4( LO_NIBBLE(DISPLAY_CLEAR) );
-    LCDPort_ClearCE();
-    LCDPort_SetDirection_Input4();
-    LCDPort_SetRW();
-
-    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy()))
-        goto out;
+    if (LCD_OPERATION_OK != status)
+        return status;
 
-    LCDPort_ClearRW();
-    LCDPort_SetCE();
-    LCDPort_Out4( HI_NIBBLE(ENTRY_MODE_SET__I_D_SH) );
-    LCDPort_SetDirection_Output4();
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_Out4( LO_NIBBLE(ENTRY_MODE_SET__I_D_SH) );
-    LCDPort_ClearCE();
-    LCDPort_SetDirection_Input4();
-    LCDPort_SetRW();
-    rs = LCDIntf_WaitWhileBusy();
+    return (LCDRing_GetLength(&intf->opQueue)) ?
+        LCD_OPERATION_PENDING : LCD_OPERATION_OK;
+}
 
-out:
-    return rs;
+/*   Leaves the address counter at the home position, like the init does. */
+static int32_t
+writeSignature(LCDIntf * intf)
+{
+    uint8_t rows[LCD_SIGNATURE_ROWS];
+    int32_t row, rs;
+
+    for (row = 0; row < LCD_SIGNATURE_ROWS; ++row)
+        rows[row] = signatureRow(row);
+
+    LCDIntf_WriteInstruction(intf,
+        SET_CGRAM_ADDRESS_CMD | LCD_SIGNATURE_CGRAM_ADDR);
+    if (LCD_OPERATION_OK != (rs = LCDIntf_WaitWhileBusy(intf)))
+        return rs;
+    if (LCD_OPERATION_OK
+            != (rs = LCDIntf_WriteDataBurst(intf, rows, LCD_SIGNATURE_ROWS)))
+        return rs;
+    LCDIntf_WriteInstruction(intf, SET_DDRAM_ADDRESS_CMD);
+
+    return LCDIntf_WaitWhileBusy(intf);
 }
 
 static int32_t
-waitWhileBusy_8BitIntf(void)
+signatureRow(int32_t row)
 {
-    int32_t rs, busyFlagReads;
+    return (LCD_SIGNATURE + row * LCD_SIGNATURE_STEP) & SIGNATURE_MASK;
+}
 
-    LCDPort_ClearRS();
-    LCDPort_SetRW();
-    LCDPort_SetCE();
-    for (rs = 1, busyFlagReads = 0;
-            rs && (busyFlagReads < BUSY_FLAG_READS_BEFORE_GIVING_UP);
-            ++busyFlagReads) {
-        rs = LCDPort_In8() & READ_INSTRUCTION__BUSY_FLAG_MASK;
+/*   Until it is told otherwise the controller listens to all 8 data lines,
+ * so on a 4-bit bus the first instruction is a single nibble.
+ */
+static void
+writeInitNibble(LCDIntf * intf, int32_t nibble)
+{
+    PORT_OP(clearRS)(intf->port);
+    prepareWrite(intf);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(out4)(intf->port, nibble);
+    driveDataLines4(intf);
+    PORT_OP(clearCE)(intf->port);
+}
+
+static inline int32_t
+waitWhileBusy_8BitIntf(LCDIntf * intf)
+{
+    int32_t rs, expired;
+    uint32_t deadline = Timestamp_microseconds() + intf->busyTimeout;
+
+    releaseDataLines8(intf);
+    PORT_OP(clearRS)(intf->port);
+    PORT_OP(setRW)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    for (;;) {
+        expired = isPastDeadline(deadline);
+        rs = PORT_OP(in8)(intf->port) & READ_INSTRUCTION__BUSY_FLAG_MASK;
+        if (!rs || expired)
+            break;
+        yieldWhileBusy(intf);
     }
-    LCDPort_ClearCE();
+    PORT_OP(clearCE)(intf->port);
 
     return rs;
 }
 
-static int32_t
-waitWhileBusy_4BitIntf(void)
-{
-    int32_t rs, busyFlagReads;
-
-    LCDPort_ClearRS();
-    LCDPort_SetRW();
-    LCDPort_SetCE();
-    for (rs = 1, busyFlagReads = 0;
-            rs && (busyFlagReads < BUSY_FLAG_READS_BEFORE_GIVING_UP);
-            ++busyFlagReads) {
-        // XXX explain better:
-        rs = (LCDPort_In4() << 4) & READ_INSTRUCTION__BUSY_FLAG_MASK;
+static inline int32_t
+waitWhileBusy_4BitIntf(LCDIntf * intf)
+{
+    int32_t rs, expired;
+    uint32_t deadline = Timestamp_microseconds() + intf->busyTimeout;
+
+    releaseDataLines4(intf);
+    PORT_OP(clearRS)(intf->port);
+    PORT_OP(setRW)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    // XXX explain better:
+    for (;;) {
+        expired = isPastDeadline(deadline);
+        rs = (PORT_OP(in4)(intf->port) << 4)
+            & READ_INSTRUCTION__BUSY_FLAG_MASK;
+        if (!rs || expired)
+            break;
+        yieldWhileBusy(intf);
     }
-    LCDPort_ClearCE();
-    LCDPort_SetCE();
-    LCDPort_In4();
-    LCDPort_ClearCE();
+    PORT_OP(clearCE)(intf->port);
+    PORT_OP(setCE)(intf->port);
+    PORT_OP(in4)(intf->port);
+    PORT_OP(clearCE)(intf->port);
 
     return rs;
 }
@@ -29,43 +29,259 @@
 #ifndef D_LCDIntf_h
 #define D_LCDIntf_h
 
+/*   Time the busy flag is given to clear: the long budget is for CLEAR and
+ * RETURN HOME, the short one for everything else.  Both leave room for a
+ * slow oscillator, which stretches the execution times.
+ */
 #ifdef TESTBUILD
-#define BUSY_FLAG_READS_BEFORE_GIVING_UP 5
+#define LCD_BUSY_TIMEOUT_SHORT_US 5
+#define LCD_BUSY_TIMEOUT_LONG_US 10
 #endif
 
-#ifndef BUSY_FLAG_READS_BEFORE_GIVING_UP
-#define BUSY_FLAG_READS_BEFORE_GIVING_UP 4000
+#ifndef LCD_BUSY_TIMEOUT_SHORT_US
+#define LCD_BUSY_TIMEOUT_SHORT_US 500
+#endif
+#ifndef LCD_BUSY_TIMEOUT_LONG_US
+#define LCD_BUSY_TIMEOUT_LONG_US 5000
 #endif
 
 #include <stdint.h>
+#include <stddef.h>
+#include "LCDTime.h"
+#include "LCDPort.h"
+#include "LCDRing.h"
+
+/*   Define LCD_INTF_DATA_WIDTH as 4 or 8 to bind the interface to that data
+ * width at build time (no run time dispatch); LCDIntf_Init() then rejects
+ * any other width with LCD_OPERATION_UNSUPPORTED.  Left undefined, the
+ * width is chosen by LCDIntf_Init().
+ *   The port operations are still called through the LCDPortOps table.
+ * To bind the port as well, define LCD_INTF_PORT_HEADER as a header (say
+ * "LCDPortInline.h") that defines every operation as a static inline
+ * LCDPortInline_<operation>() -- LCDPortInline_setCE() and so on, with the
+ * signatures of LCDPortOps.  LCDIntf calls those directly and ignores the
+ * table passed to LCDIntf_Init(), which may be NULL.  The binding is for
+ * builds with a single port, since every instance gets the same one.
+ */
+
+/*   Capacity of the queue of operations served by LCDIntf_Poll() (has to
+ * be a power of two).
+ */
+#ifndef LCD_INTF_QUEUE_SIZE
+#define LCD_INTF_QUEUE_SIZE 32
+#endif
+#if (LCD_INTF_QUEUE_SIZE <= 0) \
+    || (LCD_INTF_QUEUE_SIZE & (LCD_INTF_QUEUE_SIZE - 1))
+#error "LCD_INTF_QUEUE_SIZE has to be a power of two"
+#endif
+
+/*   Execution times of instructions (datasheet, fosc = 270kHz).  Used when
+ * readiness of the controller is predicted rather than polled.
+ */
+#ifndef LCD_EXECUTION_TIME_SHORT_US
+#define LCD_EXECUTION_TIME_SHORT_US 37
+#endif
+#ifndef LCD_EXECUTION_TIME_LONG_US
+#define LCD_EXECUTION_TIME_LONG_US 1520
+#endif
+
+/*   Time the controller needs after power on (Vcc rising to 2.7V) before
+ * it takes the first instruction.
+ */
+#ifndef LCD_POWER_ON_DELAY_US
+#define LCD_POWER_ON_DELAY_US 40000
+#endif
+
+/*   Delay after an instruction sent before the busy flag may be read
+ * (ST7066U and alike ask 39us, HD44780 itself makes do with 37us).
+ */
+#ifndef LCD_INIT_SETUP_DELAY_US
+#define LCD_INIT_SETUP_DELAY_US 39
+#endif
 
 enum {
+    FUNCTION_SET = 0x20,
+    FUNCTION_SET__8BIT = 0x10,
+    FUNCTION_SET__2LINE = 0x08,
+    FUNCTION_SET__5x10FONT = 0x04,
     FUNCTION_SET__8BIT_2LINE_8x11FONT = 0x3C,
     FUNCTION_SET__4BIT_2LINE_8x11FONT = 0x2C,
     DISPLAY_CONTROL__D_ON_C_OFF_B_OFF = 0x0C,
     DISPLAY_CLEAR = 0x01,
+    RETURN_HOME = 0x02,
+    CURSOR_OR_DISPLAY_SHIFT = 0x10,
+    CURSOR_OR_DISPLAY_SHIFT__DISPLAY = 0x08,
+    CURSOR_OR_DISPLAY_SHIFT__RIGHT = 0x04,
+    DISPLAY_SHIFT__LEFT = 0x18,
     ENTRY_MODE_SET__I_D_SH = 0x06,
+    SET_CGRAM_ADDRESS_CMD = 0x40,
     SET_DDRAM_ADDRESS_CMD = 0x80,
 };
 
+/*   Warm restart signature: a user character the initialization fills
+ * with a known pattern, so that a later probe can tell a controller that
+ * is still configured.  Row i of it holds
+ * (LCD_SIGNATURE + i * LCD_SIGNATURE_STEP) & 0x1F, and all of the rows have
+ * to match: the 40 bits leave a cold controller a 1 in 2^40 chance to pass
+ * for a configured one.  The default is user character 7, which the
+ * application must then leave alone.
+ *   The probe reads the controller, so the caller has to let
+ * LCD_POWER_ON_DELAY_US pass after power on before it probes.
+ */
+#ifndef LCD_SIGNATURE_CGRAM_ADDR
+#define LCD_SIGNATURE_CGRAM_ADDR 0x38
+#endif
+#ifndef LCD_SIGNATURE
+#define LCD_SIGNATURE 0x15
+#endif
+enum {
+    LCD_SIGNATURE_ROWS = 8,
+    LCD_SIGNATURE_STEP = 0x0B,
+};
+
+/*   Display geometry and settings the default initialization sequence
+ * ends up with.  The interface width bit of FUNCTION SET is taken care of
+ * by LCDIntf.
+ */
+#ifndef LCD_INIT_FUNCTION_SET
+#define LCD_INIT_FUNCTION_SET \
+    (FUNCTION_SET | FUNCTION_SET__2LINE | FUNCTION_SET__5x10FONT)
+#endif
+#ifndef LCD_INIT_DISPLAY_CONTROL
+#define LCD_INIT_DISPLAY_CONTROL DISPLAY_CONTROL__D_ON_C_OFF_B_OFF
+#endif
+#ifndef LCD_INIT_ENTRY_MODE
+#define LCD_INIT_ENTRY_MODE ENTRY_MODE_SET__I_D_SH
+#endif
+
+/*   A step of the controller initialization.  LCDIntf_SetInitSequence()
+ * replaces the default sequence by a table of these.
+ */
+enum {
+    LCD_INIT_STEP_INSTRUCTION = 0,  // whole instruction, at the bus width
+    LCD_INIT_STEP_4BIT_NIBBLE,      // high nibble alone, 4-bit bus only
+};
+
+enum {
+    LCD_INIT_DELAY_NONE = 0,
+    LCD_INIT_DELAY_SETUP,           // LCD_INIT_SETUP_DELAY_US
+    LCD_INIT_DELAY_SHORT,           // LCD_EXECUTION_TIME_SHORT_US
+    LCD_INIT_DELAY_LONG,            // LCD_EXECUTION_TIME_LONG_US
+};
+
+typedef struct LCDInitStep {
+    uint8_t value;                  // instruction (or its high nibble)
+    uint8_t mode;                   // LCD_INIT_STEP_*
+    uint8_t delay;                  // LCD_INIT_DELAY_*
+    uint8_t busyCheck;              // then wait while busy (or predicted)
+} LCDInitStep;
+
 enum {
     LCD_OPERATION_OK = 0,
     LCD_OPERATION_TIMEOUT,
+    LCD_OPERATION_UNSUPPORTED,
+    LCD_OPERATION_QUEUE_FULL,
+    LCD_OPERATION_PENDING,
+    LCD_OPERATION_NOT_CONFIGURED,
+    LCD_OPERATION_RESUMED,
+    LCD_OPERATION_FAULT,
     READ_INSTRUCTION__BUSY_FLAG = 0x80,
     READ_INSTRUCTION__BUSY_FLAG_MASK =  READ_INSTRUCTION__BUSY_FLAG,
     READ_INSTRUCTION__NO_BUSY_FLAG   = ~READ_INSTRUCTION__BUSY_FLAG,
 };
 
-int32_t LCDIntf_Init(int32_t lcdPortDataWidth);
-void    LCDIntf_Deinit(void);
-int32_t LCDIntf_GetPortDataWidth(void);
-void    LCDIntf_WriteInstruction(int32_t i);
-void    LCDIntf_WriteData(int32_t d);
-int32_t LCDIntf_ReadData(void);
-int32_t LCDIntf_ReadInstruction(void);
-int32_t LCDIntf_WaitWhileBusy(void);
-int32_t LCDIntf_InitializeLCDController(void);
-
-extern void Delay_microseconds(uint32_t microseconds);
+/*   Called between busy flag polls and while a predicted execution time
+ * runs out, so that the application gets on with other work meanwhile.
+ * The hook must not call LCDIntf (the bus may be mid-read) and should be
+ * short: the wait overruns by as much as the hook takes.
+ */
+typedef void (*LCDYieldHook)(void);
+
+enum {
+    LCD_BUSY_MODE_POLL = 0,     // read busy flag after every operation
+    LCD_BUSY_MODE_PREDICT,      // wait out execution time, read on demand
+    LCD_BUSY_MODE_WRITE_ONLY,   // RW tied low: wait out execution time only
+};
+
+/*   An interface instance, one per controller, so that several displays
+ * (or parallel host tests) do not share any state.  The caller provides
+ * the storage; the fields are private to LCDIntf.
+ */
+struct LCDIntfImpl;
+
+typedef struct LCDIntf {
+    const LCDPortOps * portOps;
+    void *   port;
+    const struct LCDIntfImpl * impl;    // NULL if the width is fixed
+    int8_t   portDataWidth;
+    int8_t * busDirection;              // own, or shared with others
+    int8_t   ownBusDirection;
+    int8_t   burstRS;
+
+    /*   In LCD_BUSY_MODE_PREDICT the controller is assumed to be ready once
+     * the execution time of the last operation has passed; an operation
+     * that comes earlier waits out the rest.  The busy flag is still there
+     * for the reads (probe, fault checks), it is just not polled.
+     *   LCD_BUSY_MODE_WRITE_ONLY is for boards with RW tied low: the same
+     * prediction, but nothing is ever read -- the data lines stay outputs
+     * and RW is never touched.
+     */
+    int8_t   busyMode;
+    uint32_t predictedReadyAt;
+    // budget of the next busy flag wait, by the last execution time
+    uint32_t busyTimeout;
+    // without a hook the waits spin (or sleep in Delay_microseconds())
+    LCDYieldHook yieldHook;
+
+    LCDRing  opQueue;
+    uint16_t opQueueStorage[LCD_INTF_QUEUE_SIZE];
+    int8_t   awaitingReadiness;
+    uint32_t readinessDeadline;
+
+    /*   Asynchronous initialization: LCDIntf_Poll() sends the next step
+     * once the deadline of the previous one (the power-on delay for the
+     * first one) has passed.  Writes issued meanwhile are queued behind
+     * the init; one that does not fit completes the init and goes out
+     * right away.
+     */
+    const LCDInitStep * initSequence;
+    size_t   initSequenceLength;
+    int8_t   initInProgress;
+    int8_t   initAwaitingReadiness;
+    size_t   initStepIndex;
+    uint32_t initStepReadyAt;
+    int32_t  initStatus;
+} LCDIntf;
+
+int32_t LCDIntf_Init(LCDIntf * intf, const LCDPortOps * portOps, void * port,
+        int32_t lcdPortDataWidth);
+void    LCDIntf_Deinit(LCDIntf * intf);
+int32_t LCDIntf_GetPortDataWidth(LCDIntf * intf);
+void    LCDIntf_WriteInstruction(LCDIntf * intf, int32_t i);
+void    LCDIntf_WriteData(LCDIntf * intf, int32_t d);
+int32_t LCDIntf_ReadData(LCDIntf * intf);
+int32_t LCDIntf_ReadInstruction(LCDIntf * intf);
+int32_t LCDIntf_WaitWhileBusy(LCDIntf * intf);
+int32_t LCDIntf_WriteInstructionBurst(LCDIntf * intf, const uint8_t * buf,
+        size_t n);
+int32_t LCDIntf_WriteDataBurst(LCDIntf * intf, const uint8_t * buf, size_t n);
+int32_t LCDIntf_InitializeLCDController(LCDIntf * intf);
+int32_t LCDIntf_StartLCDControllerInit(LCDIntf * intf);
+int32_t LCDIntf_GetInitStatus(LCDIntf * intf);
+int32_t LCDIntf_ProbeLCDController(LCDIntf * intf);
+int32_t LCDIntf_ResumeOrInitializeLCDController(LCDIntf * intf);
+void    LCDIntf_SetInitSequence(LCDIntf * intf, const LCDInitStep * steps,
+        size_t n);
+void    LCDIntf_SetBusyMode(LCDIntf * intf, int32_t mode);
+int32_t LCDIntf_GetBusyMode(LCDIntf * intf);
+void    LCDIntf_ShareBus(LCDIntf * intf, LCDIntf * onTheBus);
+void    LCDIntf_AwaitReadinessOf(LCDIntf * intf, const LCDIntf * other);
+void    LCDIntf_SetYieldHook(LCDIntf * intf, LCDYieldHook hook);
+int32_t LCDIntf_QueueInstruction(LCDIntf * intf, int32_t i);
+int32_t LCDIntf_QueueData(LCDIntf * intf, int32_t d);
+int32_t LCDIntf_Poll(LCDIntf * intf);
+uint32_t LCDIntf_GetQueueOverflows(LCDIntf * intf);
+uint32_t LCDIntf_GetQueueHighWatermark(LCDIntf * intf);
+int32_t LCDIntf_Drain(LCDIntf * intf);
 
 #endif /* #ifndef D_LCDIntf_h */
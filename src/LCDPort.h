@@ -37,23 +37,47 @@ enum {
     LCD_PORT_DATA_WIDTH_8_BIT = 8
 };
 
-void LCDPort_Init(int32_t lcdPortDataWidth);
-void LCDPort_Deinit(void);
-
-void LCDPort_SetDirection_Input8(void);
-void LCDPort_SetDirection_Output8(void);
-void LCDPort_SetDirection_Input4(void);
-void LCDPort_SetDirection_Output4(void);
-void LCDPort_Out4(int32_t n);
-void LCDPort_Out8(int32_t n);
-int32_t LCDPort_In4(void);
-int32_t LCDPort_In8(void);
-
-void LCDPort_SetRS(void);
-void LCDPort_ClearRS(void);
-void LCDPort_SetRW(void);
-void LCDPort_ClearRW(void);
-void LCDPort_SetCE(void);
-void LCDPort_ClearCE(void);
+/*   Whole bus cycles.  A port which is able to change RS, RW and the data
+ * lines with a single register store implements writeByte/readByte; LCDIntf
+ * then uses them instead of the per line operations (which are still needed
+ * for the controller initialization).  The choice is made per instance, a
+ * table with NULL writeByte/readByte gets the line level transfers.  Only
+ * a build with the data width or the port fixed (see LCDIntf.h) selects
+ * them with LCD_PORT_BUS_CYCLES.
+ *   writeByte() leaves the data lines driven, readByte() leaves them as
+ * inputs.  On a 4-bit port both transfer two nibbles, the high one first.
+ */
+enum {
+    LCD_PORT_RS_INSTRUCTION = 0,
+    LCD_PORT_RS_DATA = 1
+};
+
+/*   Port operations.  A port implementation exports a table of these;
+ * every operation gets the port's own context (which pins, which GPIO
+ * block, ...) first, so that one implementation serves several panels.
+ */
+typedef struct LCDPortOps {
+    void    (*init)(void * port, int32_t lcdPortDataWidth);
+    void    (*deinit)(void * port);
+
+    void    (*setDirection_Input8)(void * port);
+    void    (*setDirection_Output8)(void * port);
+    void    (*setDirection_Input4)(void * port);
+    void    (*setDirection_Output4)(void * port);
+    void    (*out4)(void * port, int32_t n);
+    void    (*out8)(void * port, int32_t n);
+    int32_t (*in4)(void * port);
+    int32_t (*in8)(void * port);
+
+    void    (*setRS)(void * port);
+    void    (*clearRS)(void * port);
+    void    (*setRW)(void * port);
+    void    (*clearRW)(void * port);
+    void    (*setCE)(void * port);
+    void    (*clearCE)(void * port);
+
+    void    (*writeByte)(void * port, int32_t rs, int32_t value);
+    int32_t (*readByte)(void * port, int32_t rs);
+} LCDPortOps;
 
 #endif /* #ifndef D_LCDPort_h */
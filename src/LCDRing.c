@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdint.h>
+#include "LCDRing.h"
+
+/*   An index is published with release semantics, so the entry written
+ * before it is visible to the other side, which loads it with acquire
+ * semantics.  On a single core Cortex-M aligned 32-bit accesses are
+ * atomic anyway, and only the compiler has to be kept from reordering.
+ */
+#if defined(__GNUC__)
+#define LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define LOAD_ACQUIRE(p)     (*(volatile uint32_t *)(p))
+#define STORE_RELEASE(p, v) (*(volatile uint32_t *)(p) = (v))
+#endif
+
+int32_t
+LCDRing_Init(LCDRing * ring, uint16_t * storage, uint32_t size)
+{
+    if ((0 == size) || (size & (size - 1)))
+        return LCD_RING_BAD_SIZE;
+
+    ring->entries = storage;
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->overflows = 0;
+    ring->highWatermark = 0;
+
+    return LCD_RING_OK;
+}
+
+int32_t
+LCDRing_Put(LCDRing * ring, uint16_t entry)
+{
+    uint32_t length, tail = ring->tail;
+
+    length = tail - LOAD_ACQUIRE(&ring->head);
+    if (length > ring->mask) {
+        ++ring->overflows;
+        return LCD_RING_FULL;
+    }
+
+    ring->entries[tail & ring->mask] = entry;
+    STORE_RELEASE(&ring->tail, tail + 1);
+
+    if (++length > ring->highWatermark)
+        ring->highWatermark = length;
+
+    return LCD_RING_OK;
+}
+
+int32_t
+LCDRing_Peek(LCDRing * ring, uint16_t * pEntry)
+{
+    uint32_t head = ring->head;
+
+    if (head == LOAD_ACQUIRE(&ring->tail))
+        return LCD_RING_EMPTY;
+
+    *pEntry = ring->entries[head & ring->mask];
+
+    return LCD_RING_OK;
+}
+
+/*   Releases the entry returned by the last successful LCDRing_Peek(). */
+void
+LCDRing_Drop(LCDRing * ring)
+{
+    STORE_RELEASE(&ring->head, ring->head + 1);
+}
+
+/*   Consumer side: throws away everything queued so far. */
+void
+LCDRing_Flush(LCDRing * ring)
+{
+    STORE_RELEASE(&ring->head, LOAD_ACQUIRE(&ring->tail));
+}
+
+uint32_t
+LCDRing_GetLength(LCDRing * ring)
+{
+    return LOAD_ACQUIRE(&ring->tail) - LOAD_ACQUIRE(&ring->head);
+}
+
+uint32_t
+LCDRing_GetOverflows(LCDRing * ring)
+{
+    return ring->overflows;
+}
+
+uint32_t
+LCDRing_GetHighWatermark(LCDRing * ring)
+{
+    return ring->highWatermark;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_LCDRing_h
+#define D_LCDRing_h
+
+#include <stdint.h>
+
+/*   Lock-free single-producer/single-consumer ring of 16-bit entries.
+ * The producer (e.g. main loop) only calls LCDRing_Put(), the consumer
+ * (e.g. a timer ISR) only calls LCDRing_Peek()/LCDRing_Drop().  Each side
+ * writes its own index only, so no critical sections are needed.
+ *   Size of the storage has to be a power of two.
+ */
+enum {
+    LCD_RING_OK = 0,
+    LCD_RING_FULL,
+    LCD_RING_EMPTY,
+    LCD_RING_BAD_SIZE,
+};
+
+typedef struct LCDRing {
+    uint16_t * entries;
+    uint32_t   mask;
+    uint32_t   head;            // consumer owned
+    uint32_t   tail;            // producer owned
+    uint32_t   overflows;       // producer owned
+    uint32_t   highWatermark;   // producer owned
+} LCDRing;
+
+int32_t  LCDRing_Init(LCDRing * ring, uint16_t * storage, uint32_t size);
+int32_t  LCDRing_Put(LCDRing * ring, uint16_t entry);
+int32_t  LCDRing_Peek(LCDRing * ring, uint16_t * pEntry);
+void     LCDRing_Drop(LCDRing * ring);
+void     LCDRing_Flush(LCDRing * ring);
+uint32_t LCDRing_GetLength(LCDRing * ring);
+uint32_t LCDRing_GetOverflows(LCDRing * ring);
+uint32_t LCDRing_GetHighWatermark(LCDRing * ring);
+
+#endif /* #ifndef D_LCDRing_h */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_LCDTime_h
+#define D_LCDTime_h
+
+#include <stdint.h>
+
+/*   Microsecond time service used by LCDIntf for the controller
+ * initialization delays and for predicted busy handling.  The platform
+ * links exactly one implementation in (examples/LCDTime_DWT.c,
+ * examples/LCDTime_SysTick.c or, on a host, examples/LCDTime_Host.c).
+ *   LCDTime_Init() has to be called before any other LCD module is used.
+ *   Delay_microseconds() waits at least the given time.
+ *   Timestamp_microseconds() is a free running counter, wrapping around
+ * at 2^32; compare time stamps by their difference only.
+ */
+void LCDTime_Init(void);
+void Delay_microseconds(uint32_t microseconds);
+uint32_t Timestamp_microseconds(void);
+
+#endif /* #ifndef D_LCDTime_h */
@@ -1,5 +1,6 @@
 #include "CppUTest/TestHarness.h"
 #include <stdint.h>
+#include <string.h>
 extern "C"
 {
 #include "LCDDriver.h"
@@ -8,10 +9,15 @@ extern "C"
 };
 #include "LCDIntfMock.h"
 
-struct LCDDriver : public Utest
+static LCDIntf intf;
+static LCDDriver lcd;
+
+struct LCDDriverTest : public Utest
 {
     void setup() override {
-        MockPeriphIO_Create(25);
+        MockPeriphIO_Create(50);
+        LCDIntfMock_Reset();
+        LCDDriver_Init(&lcd, &intf);
     }
     void teardown() override {
         MockPeriphIO_Verify_Complete();
@@ -20,7 +26,7 @@ struct LCDDriver : public Utest
 };
 
 /* ====================================================================== */
-TEST_GROUP_BASE(AnLCDDriver_Clear, LCDDriver)
+TEST_GROUP_BASE(AnLCDDriver_Clear, LCDDriverTest)
 {
 };
 
@@ -28,7 +34,7 @@ TEST(AnLCDDriver_Clear, SendsCorrectCommandSequence) {
     LCDIntfMock_Expect_WriteInstruction(DISPLAY_CLEAR);
     LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_COMPLETE);
 
-    int32_t status = LCDDriver_Clear();
+    int32_t status = LCDDriver_Clear(&lcd);
 
     LONGS_EQUAL(LCDINTFMOCK_WAIT_COMPLETE, status);
 }
@@ -37,22 +43,22 @@ TEST(AnLCDDriver_Clear, ReportsOperationStatus) {
     LCDIntfMock_Expect_WriteInstruction(DISPLAY_CLEAR);
     LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_TIMEOUT);
 
-    LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT, LCDDriver_Clear());
+    LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT, LCDDriver_Clear(&lcd));
 }
 
 /* ====================================================================== */
-TEST_GROUP_BASE(AnLCDDriver_GotoXY, LCDDriver)
+TEST_GROUP_BASE(AnLCDDriver_GotoXY, LCDDriverTest)
 {
     int16_t screenWidth, screenHeight;
 
     void setup() override {
-        LCDDriver::setup();
+        LCDDriverTest::setup();
         screenWidth  = 20;
         screenHeight = 4;
-        LCDDriver_SetupScreenDimensions(screenWidth, screenHeight);
+        LCDDriver_SetupScreenDimensions(&lcd, screenWidth, screenHeight);
     }
     void teardown() override {
-        LCDDriver::teardown();
+        LCDDriverTest::teardown();
     }
     void Expect_Command_Sequence(int32_t lcdWriteInstruction) {
         LCDIntfMock_Expect_WriteInstruction(lcdWriteInstruction);
@@ -63,91 +69,94 @@ TEST_GROUP_BASE(AnLCDDriver_GotoXY, LCDDriver)
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForTopLeftPosition) {
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
 
-    LCDDriver_GotoXY(0, 0);
+    LCDDriver_GotoXY(&lcd, 0, 0);
 }
 
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForTopRightPosition) {
     int16_t x = screenWidth - 1, y = 0;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | x);
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForLeftmostPositionOfSecondRow) {
     int16_t x = 0, y = 1;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForRightmostPositionOfSecondRow) {
     int16_t x = (screenWidth - 1), y = 1;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | (0x40 + x));
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForLeftmostPositionOfThirdRow) {
     int16_t x = 0, y = 2;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | screenWidth);
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForRightmostPositionOfThirdRow) {
     int16_t x = (screenWidth - 1), y = 2;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | (screenWidth + x));
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForLeftmostPositionOfFourhRow) {
     int16_t x = 0, y = 3;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | (0x40 + screenWidth + x));
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, SetsDDRAMAddrForRightmostPositionOfFourhRow) {
     int16_t x = (screenWidth - 1), y = 3;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | (0x40 + screenWidth + x));
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, HandlesOtherScreenSizes_RightmostBottomPosition) {
     screenWidth  = 16;
     screenHeight = 4;
-    LCDDriver_SetupScreenDimensions(screenWidth, screenHeight);
+    LCDDriver_SetupScreenDimensions(&lcd, screenWidth, screenHeight);
 
     int16_t x = (screenWidth - 1), y = 3;
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | (0x40 + screenWidth + x));
 
-    LCDDriver_GotoXY(x, y);
+    LCDDriver_GotoXY(&lcd, x, y);
 }
 
 TEST(AnLCDDriver_GotoXY, IgnoresNegativeXValues) {
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
 
-    LCDDriver_GotoXY(-1, 0);
-    LCDDriver_GotoXY(-2, 0);
+    LCDDriver_GotoXY(&lcd, -1, 0);
+    LCDDriver_InvalidateAddressCache(&lcd);
+    LCDDriver_GotoXY(&lcd, -2, 0);
 }
 
 TEST(AnLCDDriver_GotoXY, IgnoresNegativeYValues) {
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
 
-    LCDDriver_GotoXY(0, -1);
-    LCDDriver_GotoXY(0, -2);
+    LCDDriver_GotoXY(&lcd, 0, -1);
+    LCDDriver_InvalidateAddressCache(&lcd);
+    LCDDriver_GotoXY(&lcd, 0, -2);
 }
 
 TEST(AnLCDDriver_GotoXY, IgnoresXValuePastTheScreenWidth) {
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
 
-    LCDDriver_GotoXY(screenWidth,     0);
-    LCDDriver_GotoXY(screenWidth + 1, 0);
+    LCDDriver_GotoXY(&lcd, screenWidth,     0);
+    LCDDriver_InvalidateAddressCache(&lcd);
+    LCDDriver_GotoXY(&lcd, screenWidth + 1, 0);
 }
 
 // XXX consider better test name
@@ -155,21 +164,69 @@ TEST(AnLCDDriver_GotoXY, IgnoresYValuePastTheScreenHeight) {
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
     Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
 
-    LCDDriver_GotoXY(0, screenHeight);
-    LCDDriver_GotoXY(0, screenHeight + 1);
+    LCDDriver_GotoXY(&lcd, 0, screenHeight);
+    LCDDriver_InvalidateAddressCache(&lcd);
+    LCDDriver_GotoXY(&lcd, 0, screenHeight + 1);
 }
 
 TEST(AnLCDDriver_GotoXY, DetectsCommandTimeout) {
     LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD);
     LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_TIMEOUT);
 
-    int32_t status = LCDDriver_GotoXY(0, 0);
+    int32_t status = LCDDriver_GotoXY(&lcd, 0, 0);
 
     LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT, status);
 }
 
+TEST(AnLCDDriver_GotoXY, SkipsCommandWhenCursorIsAlreadyThere) {
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 5);
+
+    LCDDriver_GotoXY(&lcd, 5, 0);
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_GotoXY(&lcd, 5, 0));
+}
+
+TEST(AnLCDDriver_GotoXY, FollowsAddressAutoIncrementAfterPutc) {
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 5);
+    LCDIntfMock_Expect_WriteData('a');
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+
+    LCDDriver_GotoXY(&lcd, 5, 0);
+    LCDDriver_Putc(&lcd, 'a');
+    LCDDriver_GotoXY(&lcd, 6, 0);
+}
+
+TEST(AnLCDDriver_GotoXY, FollowsWrapFromFirstToSecondDDRAMLine) {
+    screenWidth  = 20;
+    screenHeight = 4;
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x27);
+    LCDIntfMock_Expect_WriteData('a');
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+
+    LCDDriver_GotoXY(&lcd, screenWidth - 1, 2);
+    LCDDriver_Putc(&lcd, 'a');
+    LCDDriver_GotoXY(&lcd, 0, 1);
+}
+
+TEST(AnLCDDriver_GotoXY, KnowsThatClearHomesTheCursor) {
+    LCDIntfMock_Expect_WriteInstruction(DISPLAY_CLEAR);
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+
+    LCDDriver_Clear(&lcd);
+    LCDDriver_GotoXY(&lcd, 0, 0);
+}
+
+TEST(AnLCDDriver_GotoXY, ForgetsCursorPositionAfterTimeout) {
+    LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD);
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_TIMEOUT);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
+
+    LCDDriver_GotoXY(&lcd, 0, 0);
+    LCDDriver_ClearFault(&lcd);
+    LCDDriver_GotoXY(&lcd, 0, 0);
+}
+
 /* ====================================================================== */
-struct LCDDriver_PutX : public LCDDriver
+struct LCDDriver_PutX : public LCDDriverTest
 {
     void Expect_Data_Sequence(int32_t ch,
             int32_t waitStatus = LCDINTFMOCK_WAIT_COMPLETE) {
@@ -185,14 +242,14 @@ TEST_GROUP_BASE(AnLCDDriver_Putc, LCDDriver_PutX)
 TEST(AnLCDDriver_Putc, SendsCorrectDataSequence) {
     Expect_Data_Sequence('A');
 
-    LCDDriver_Putc('A');
+    LCDDriver_Putc(&lcd, 'A');
 }
 
 // XXX consider better test name
 TEST(AnLCDDriver_Putc, ReturnsCommandStatus) {
     Expect_Data_Sequence('B');
 
-    int32_t status = LCDDriver_Putc('B');
+    int32_t status = LCDDriver_Putc(&lcd, 'B');
 
     LONGS_EQUAL(LCDINTFMOCK_WAIT_COMPLETE, status);
 }
@@ -200,7 +257,7 @@ TEST(AnLCDDriver_Putc, ReturnsCommandStatus) {
 TEST(AnLCDDriver_Putc, DetectsCommandTimeout) {
     Expect_Data_Sequence('T', LCDINTFMOCK_WAIT_TIMEOUT);
 
-    int32_t status = LCDDriver_Putc('T');
+    int32_t status = LCDDriver_Putc(&lcd, 'T');
 
     LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT, status);
 }
@@ -208,15 +265,15 @@ TEST(AnLCDDriver_Putc, DetectsCommandTimeout) {
 TEST(AnLCDDriver_Putc, ReplacesNegativeCharCodeBySpace) {
     Expect_Data_Sequence(' ');
 
-    LCDDriver_Putc(-1);
+    LCDDriver_Putc(&lcd, -1);
 }
 
 TEST(AnLCDDriver_Putc, ReplacesLargeCharCodesBySpace) {
     Expect_Data_Sequence(' ');
     Expect_Data_Sequence(' ');
 
-    LCDDriver_Putc(256);
-    LCDDriver_Putc(12345);
+    LCDDriver_Putc(&lcd, 256);
+    LCDDriver_Putc(&lcd, 12345);
 }
 
 /* ====================================================================== */
@@ -225,79 +282,784 @@ TEST_GROUP_BASE(AnLCDDriver_Puts, LCDDriver_PutX)
     int16_t screenWidth, screenHeight;
 
     void setup() override {
-        LCDDriver::setup();
+        LCDDriverTest::setup();
         screenWidth  = 20;
         screenHeight = 4;
-        LCDDriver_SetupScreenDimensions(screenWidth, screenHeight);
+        LCDDriver_SetupScreenDimensions(&lcd, screenWidth, screenHeight);
     }
 };
 
 TEST(AnLCDDriver_Puts, IsNullPointerTolerant) {
     LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_COMPLETE);
 
-    LCDDriver_Puts(NULL);
+    LCDDriver_Puts(&lcd, NULL);
 }
 
 TEST(AnLCDDriver_Puts, HandlesEmptyStrings) {
     LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_COMPLETE);
 
-    LCDDriver_Puts((int8_t*)"");
+    LCDDriver_Puts(&lcd, (int8_t*)"");
 }
 
 TEST(AnLCDDriver_Puts, OutputsOneCharacter) {
-    Expect_Data_Sequence('S');
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("S",
+        LCDINTFMOCK_WAIT_COMPLETE);
 
-    LCDDriver_Puts((int8_t*)"S");
+    LCDDriver_Puts(&lcd, (int8_t*)"S");
 }
 
 TEST(AnLCDDriver_Puts, DetectsWriteDataTimeout) {
-    Expect_Data_Sequence('S', LCDINTFMOCK_WAIT_TIMEOUT);
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("S",
+        LCDINTFMOCK_WAIT_TIMEOUT);
 
-    int32_t status = LCDDriver_Puts((int8_t*)"S");
+    int32_t status = LCDDriver_Puts(&lcd, (int8_t*)"S");
 
     LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT, status);
 }
 
-TEST(AnLCDDriver_Puts, OutputsTwoChars) {
-    Expect_Data_Sequence('S');
-    Expect_Data_Sequence('t');
+TEST(AnLCDDriver_Puts, OutputsSeveralCharsInOneBurst) {
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("String",
+        LCDINTFMOCK_WAIT_COMPLETE);
 
-    LCDDriver_Puts((int8_t*)"St");
+    LONGS_EQUAL(LCDINTFMOCK_WAIT_COMPLETE,
+        LCDDriver_Puts(&lcd, (int8_t*)"String"));
 }
 
-TEST(AnLCDDriver_Puts, OutputsSeveralChars) {
-    Expect_Data_Sequence('S');
-    Expect_Data_Sequence('t');
-    Expect_Data_Sequence('r');
-    Expect_Data_Sequence('i');
-    Expect_Data_Sequence('n');
-    Expect_Data_Sequence('g');
+TEST(AnLCDDriver_Puts, OutputsNoMoreThanScreenWidthChars) {
+    screenWidth  = 4;
+    LCDDriver_SetupScreenDimensions(&lcd, screenWidth, screenHeight);
 
-    LCDDriver_Puts((int8_t*)"String");
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("Stri",
+        LCDINTFMOCK_WAIT_COMPLETE);
+
+    LCDDriver_Puts(&lcd, (int8_t*)"String");
 }
 
+TEST(AnLCDDriver_Puts, ReplacesNegativeCharCodesBySpace) {
+    LCDIntfMock_Expect_WriteDataBurstThenReturn(" a",
+        LCDINTFMOCK_WAIT_COMPLETE);
 
-TEST(AnLCDDriver_Puts, OutputsNoMoreThanScreenWidthChars) {
-    screenWidth  = 4;
-    LCDDriver_SetupScreenDimensions(screenWidth, screenHeight);
+    LCDDriver_Puts(&lcd, (int8_t*)"\xFF" "a");
+}
 
-    Expect_Data_Sequence('S');
-    Expect_Data_Sequence('t');
-    Expect_Data_Sequence('r');
-    Expect_Data_Sequence('i');
+TEST(AnLCDDriver_Puts, FollowsAddressAutoIncrement) {
+    LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD | 5);
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("ab", LCD_OPERATION_OK);
 
-    LCDDriver_Puts((int8_t*)"String");
+    LCDDriver_GotoXY(&lcd, 5, 0);
+    LCDDriver_Puts(&lcd, (int8_t*)"ab");
+    LCDDriver_GotoXY(&lcd, 7, 0);
 }
 
-TEST(AnLCDDriver_Puts, ReportsLastCommandStatus) {
-    // Current driver implementation prefers simplicity to effectiveness,
-    // thus we won't break operation at (first) timeout.
-    Expect_Data_Sequence('a', LCDINTFMOCK_WAIT_TIMEOUT);
-    Expect_Data_Sequence('b', LCDINTFMOCK_WAIT_TIMEOUT);
-    Expect_Data_Sequence('c');
+TEST(AnLCDDriver_Puts, ForgetsCursorPositionAfterFailedBurst) {
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("ab", LCD_OPERATION_TIMEOUT);
+    LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD);
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
 
-    int32_t status = LCDDriver_Puts((int8_t*)"abc");
+    LCDDriver_Puts(&lcd, (int8_t*)"ab");
+    LCDDriver_ClearFault(&lcd);
+    LCDDriver_GotoXY(&lcd, 0, 0);
+}
 
-    LONGS_EQUAL(LCDINTFMOCK_WAIT_COMPLETE, status);
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDDriver_PutText, LCDDriver_PutX)
+{
+    int16_t written;
+
+    void setup() override {
+        LCDDriverTest::setup();
+        LCDDriver_SetupScreenDimensions(&lcd, 4, 2);
+        written = -1;
+    }
+    void Expect_Row(int32_t addr, const char * cells,
+            int32_t status = LCD_OPERATION_OK) {
+        LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD | addr);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+        LCDIntfMock_Expect_WriteDataBurstThenReturn(cells, status);
+    }
+    int32_t putText(int16_t x, int16_t y, const char * str,
+            int32_t mode = LCDDRIVER_TEXT_WRAP) {
+        return LCDDriver_PutText(&lcd, x, y, (const int8_t*)str, mode,
+            &written);
+    }
+};
+
+TEST(AnLCDDriver_PutText, IsNullPointerTolerant) {
+    LONGS_EQUAL(LCD_OPERATION_OK, putText(0, 0, NULL));
+    LONGS_EQUAL(0, written);
+}
+
+TEST(AnLCDDriver_PutText, SetsAddressOncePerRow) {
+    Expect_Row(0x01, "abc");
+    Expect_Row(0x40, "def");
+
+    LONGS_EQUAL(LCD_OPERATION_OK, putText(1, 0, "abcdef"));
+    LONGS_EQUAL(6, written);
+}
+
+TEST(AnLCDDriver_PutText, StartsNextRowAtNewline) {
+    Expect_Row(0x00, "ab");
+    Expect_Row(0x40, "cd");
+
+    putText(0, 0, "ab\ncd");
+    LONGS_EQUAL(4, written);
+}
+
+TEST(AnLCDDriver_PutText, TakesNewlineAfterFullRowAsTheWrap) {
+    Expect_Row(0x00, "abcd");
+    Expect_Row(0x40, "ef");
+
+    putText(0, 0, "abcd\nef");
+    LONGS_EQUAL(6, written);
+}
+
+TEST(AnLCDDriver_PutText, DropsRestOfLineWhenClipping) {
+    Expect_Row(0x00, "abcd");
+    Expect_Row(0x40, "gh");
+
+    putText(0, 0, "abcdef\ngh", LCDDRIVER_TEXT_CLIP);
+    LONGS_EQUAL(6, written);
+}
+
+TEST(AnLCDDriver_PutText, EndsWithTheLastRow) {
+    Expect_Row(0x40, "abcd");
+
+    putText(0, 1, "abcdef");
+    LONGS_EQUAL(4, written);
+}
+
+TEST(AnLCDDriver_PutText, SkipsAddressWhenCursorIsAlreadyThere) {
+    Expect_Row(0x00, "ab");
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("cd", LCD_OPERATION_OK);
+
+    putText(0, 0, "ab");
+    putText(2, 0, "cd");
+}
+
+TEST(AnLCDDriver_PutText, CountsCharactersUpToFailedBurst) {
+    Expect_Row(0x00, "abcd");
+    Expect_Row(0x40, "ef", LCD_OPERATION_TIMEOUT);
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, putText(0, 0, "abcdef"));
+    LONGS_EQUAL(4, written);
+}
+
+TEST(AnLCDDriver_PutText, SetsAddressForEverySegmentOfRow) {
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_16x1);
+    Expect_Row(0x06, "ab");
+    Expect_Row(0x40, "cd");
+
+    putText(6, 0, "abcd");
+}
+
+TEST(AnLCDDriver_PutText, WritesIntoShadowWithoutTouchingTheBus) {
+    LCDDriver_EnableShadow(&lcd);
+
+    putText(2, 0, "abcd");
+    LCDDriver_Putc(&lcd, 'e');
+
+    MEMCMP_EQUAL("  abcde ", lcd.shadowCells, 8);
+    LONGS_EQUAL(4, written);
+    LCDDriver_DisableShadow(&lcd);
+}
+
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDDriver_Shadow, LCDDriver_PutX)
+{
+    int16_t screenWidth, screenHeight;
+
+    void setup() override {
+        LCDDriverTest::setup();
+        screenWidth  = 4;
+        screenHeight = 2;
+        LCDDriver_SetupScreenDimensions(&lcd, screenWidth, screenHeight);
+        LCDDriver_EnableShadow(&lcd);
+    }
+    void teardown() override {
+        LCDDriver_DisableShadow(&lcd);
+        LCDDriverTest::teardown();
+    }
+    void Expect_Command_Sequence(int32_t lcdWriteInstruction) {
+        LCDIntfMock_Expect_WriteInstruction(lcdWriteInstruction);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+    }
+    void Expect_Cells_Burst(const char * cells,
+            int32_t status = LCD_OPERATION_OK) {
+        LCDIntfMock_Expect_WriteDataBurstThenReturn(cells, status);
+    }
+    void Expect_Row_Of_Spaces(int32_t addr) {
+        char row[LCDDRIVER_SHADOW_CELLS + 1] = "";
+
+        for (int i = 0; i < screenWidth; ++i)
+            row[i] = ' ';
+        Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | addr);
+        Expect_Cells_Burst(row);
+    }
+    void FlushInitialScreen() {
+        Expect_Row_Of_Spaces(0x00);
+        Expect_Row_Of_Spaces(0x40);
+        LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Flush(&lcd));
+    }
+};
+
+TEST(AnLCDDriver_Shadow, DoesNotTouchTheBusOnWrites) {
+    LCDDriver_Clear(&lcd);
+    LCDDriver_GotoXY(&lcd, 1, 1);
+    LCDDriver_Putc(&lcd, 'A');
+    LCDDriver_Puts(&lcd, (int8_t*)"Str");
+}
+
+TEST(AnLCDDriver_Shadow, FirstFlushRewritesWholeScreen) {
+    FlushInitialScreen();
+}
+
+TEST(AnLCDDriver_Shadow, FlushWithoutChangesIsNoop) {
+    FlushInitialScreen();
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Flush(&lcd));
+}
+
+TEST(AnLCDDriver_Shadow, FlushPushesChangedCellsOnly) {
+    FlushInitialScreen();
+    LCDDriver_GotoXY(&lcd, 2, 1);
+    LCDDriver_Putc(&lcd, '7');
+
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | (0x40 + 2));
+    Expect_Cells_Burst("7");
+
+    LCDDriver_Flush(&lcd);
+}
+
+TEST(AnLCDDriver_Shadow, RewritingSameCharDoesNotDirtyCell) {
+    FlushInitialScreen();
+    LCDDriver_GotoXY(&lcd, 0, 0);
+    LCDDriver_Puts(&lcd, (int8_t*)"  ");
+
+    LCDDriver_Flush(&lcd);
+}
+
+TEST(AnLCDDriver_Shadow, SetsAddressOncePerRunOfAdjacentCells) {
+    FlushInitialScreen();
+    LCDDriver_GotoXY(&lcd, 1, 0);
+    LCDDriver_Puts(&lcd, (int8_t*)"ab");
+
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 1);
+    Expect_Cells_Burst("ab");
+
+    LCDDriver_Flush(&lcd);
+}
+
+TEST(AnLCDDriver_Shadow, ClearOnlyDirtiesNonBlankCells) {
+    FlushInitialScreen();
+    LCDDriver_GotoXY(&lcd, 3, 0);
+    LCDDriver_Putc(&lcd, 'x');
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 3);
+    Expect_Cells_Burst("x");
+    LCDDriver_Flush(&lcd);
+    LCDDriver_Clear(&lcd);
+
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 3);
+    Expect_Cells_Burst(" ");
+
+    LCDDriver_Flush(&lcd);
+}
+
+TEST(AnLCDDriver_Shadow, KeepsCellsDirtyAfterTimeout) {
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD);
+    Expect_Cells_Burst("    ", LCD_OPERATION_TIMEOUT);
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDDriver_Flush(&lcd));
+    LCDDriver_ClearFault(&lcd);
+
+    FlushInitialScreen();
+}
+
+TEST(AnLCDDriver_Shadow, RejectsScreensLargerThanShadow) {
+    LCDDriver_DisableShadow(&lcd);
+    LCDDriver_SetupScreenDimensions(&lcd, LCDDRIVER_SHADOW_CELLS + 1, 1);
+
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, LCDDriver_EnableShadow(&lcd));
+}
+
+TEST(AnLCDDriver_Shadow, RewritesSingleCleanCellInsteadOfJumping) {
+    FlushInitialScreen();
+    LCDDriver_GotoXY(&lcd, 0, 1);
+    LCDDriver_Putc(&lcd, 'a');
+    LCDDriver_GotoXY(&lcd, 2, 1);
+    LCDDriver_Putc(&lcd, 'b');
+
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
+    Expect_Cells_Burst("a b");
+
+    LCDDriver_Flush(&lcd);
+}
+
+TEST(AnLCDDriver_Shadow, JumpsOverWiderGaps) {
+    FlushInitialScreen();
+    LCDDriver_GotoXY(&lcd, 0, 1);
+    LCDDriver_Putc(&lcd, 'a');
+    LCDDriver_GotoXY(&lcd, 3, 1);
+    LCDDriver_Putc(&lcd, 'b');
+
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
+    Expect_Cells_Burst("a");
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x43);
+    Expect_Cells_Burst("b");
+
+    LCDDriver_Flush(&lcd);
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDDriver_LoadShadow, LCDDriver_PutX)
+{
+    void setup() override {
+        LCDDriverTest::setup();
+        LCDDriver_SetupScreenDimensions(&lcd, 2, 2);
+    }
+    void teardown() override {
+        LCDDriver_DisableShadow(&lcd);
+        LCDDriverTest::teardown();
+    }
+    void Expect_Command_Sequence(int32_t lcdWriteInstruction) {
+        LCDIntfMock_Expect_WriteInstruction(lcdWriteInstruction);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+    }
+    void Expect_Read_Sequence(int32_t ch,
+            int32_t waitStatus = LCDINTFMOCK_WAIT_COMPLETE) {
+        LCDIntfMock_Expect_ReadDataThenReturn(ch);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(waitStatus);
+    }
+    void Expect_Screen_Read(const char * row0, const char * row1) {
+        Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x00);
+        Expect_Read_Sequence(row0[0]);
+        Expect_Read_Sequence(row0[1]);
+        Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
+        Expect_Read_Sequence(row1[0]);
+        Expect_Read_Sequence(row1[1]);
+    }
+};
+
+TEST(AnLCDDriver_LoadShadow, ReadsScreenRowByRow) {
+    Expect_Screen_Read("ab", "cd");
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_LoadShadow(&lcd));
+}
+
+TEST(AnLCDDriver_LoadShadow, LeavesNothingToFlush) {
+    Expect_Screen_Read("ab", "cd");
+    LCDDriver_LoadShadow(&lcd);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Flush(&lcd));
+}
+
+TEST(AnLCDDriver_LoadShadow, FlushesOnlyCellsChangedAfterLoad) {
+    Expect_Screen_Read("ab", "cd");
+    LCDDriver_LoadShadow(&lcd);
+    LCDDriver_GotoXY(&lcd, 0, 1);
+    LCDDriver_Puts(&lcd, (int8_t*)"cX");
+
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x41);
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("X", LCD_OPERATION_OK);
+
+    LCDDriver_Flush(&lcd);
 }
 
+TEST(AnLCDDriver_LoadShadow, FailsWithoutReadableController) {
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x00);
+    LCDIntfMock_Expect_ReadDataThenReturn(-1);
+
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, LCDDriver_LoadShadow(&lcd));
+}
+
+TEST(AnLCDDriver_LoadShadow, StopsAtTimeout) {
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x00);
+    Expect_Read_Sequence('a', LCDINTFMOCK_WAIT_TIMEOUT);
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDDriver_LoadShadow(&lcd));
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDDriver_Fault, LCDDriver_PutX)
+{
+    void setup() override {
+        LCDDriverTest::setup();
+        LCDIntfMock_Microseconds = 0;
+        LCDDriver_SetupScreenDimensions(&lcd, 4, 1);
+        Expect_Data_Sequence('a', LCDINTFMOCK_WAIT_TIMEOUT);
+        LCDDriver_Putc(&lcd, 'a');
+    }
+    void teardown() override {
+        LCDDriver_DisableShadow(&lcd);
+        LCDDriverTest::teardown();
+    }
+    void WaitOutBackoff() {
+        LCDIntfMock_Microseconds += LCDDRIVER_FAULT_BACKOFF_US;
+    }
+};
+
+TEST(AnLCDDriver_Fault, FailsFastAfterTimeout) {
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_Putc(&lcd, 'b'));
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_Puts(&lcd, (int8_t*)"bc"));
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_GotoXY(&lcd, 1, 0));
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_Clear(&lcd));
+}
+
+TEST(AnLCDDriver_Fault, ReprobesOnlyAfterBackoff) {
+    LCDIntfMock_Microseconds += LCDDRIVER_FAULT_BACKOFF_US - 1;
+
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_Putc(&lcd, 'b'));
+}
+
+TEST(AnLCDDriver_Fault, StaysFaultedWhileControllerIsBusy) {
+    WaitOutBackoff();
+    LCDIntfMock_Expect_ReadInstructionThenReturn(READ_INSTRUCTION__BUSY_FLAG);
+
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_Putc(&lcd, 'b'));
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_Putc(&lcd, 'b'));
+}
+
+TEST(AnLCDDriver_Fault, BacksOffAgainAfterFailedReprobe) {
+    WaitOutBackoff();
+    LCDIntfMock_Expect_ReadInstructionThenReturn(READ_INSTRUCTION__BUSY_FLAG);
+    LCDDriver_Putc(&lcd, 'b');
+    WaitOutBackoff();
+    LCDIntfMock_Expect_ReadInstructionThenReturn(0);
+    Expect_Data_Sequence('b');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Putc(&lcd, 'b'));
+}
+
+TEST(AnLCDDriver_Fault, RecoversWhenControllerAnswers) {
+    WaitOutBackoff();
+    LCDIntfMock_Expect_ReadInstructionThenReturn(0);
+    LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD | 1);
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCD_OPERATION_OK);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_GotoXY(&lcd, 1, 0));
+}
+
+TEST(AnLCDDriver_Fault, RetriesOperationWithoutRWLine) {
+    WaitOutBackoff();
+    LCDIntfMock_Expect_ReadInstructionThenReturn(-1);
+    Expect_Data_Sequence('b');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Putc(&lcd, 'b'));
+}
+
+TEST(AnLCDDriver_Fault, FailsFlushFast) {
+    LCDDriver_EnableShadow(&lcd);
+    LCDDriver_Putc(&lcd, 'b');
+
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_Flush(&lcd));
+}
+
+TEST(AnLCDDriver_Fault, IsLeftBehindByClearFault) {
+    LCDDriver_ClearFault(&lcd);
+    Expect_Data_Sequence('b');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Putc(&lcd, 'b'));
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDDriver_Geometry, LCDDriver_PutX)
+{
+    void teardown() override {
+        LCDDriver_DisableShadow(&lcd);
+        LCDDriverTest::teardown();
+    }
+    void Expect_Command_Sequence(int32_t lcdWriteInstruction) {
+        LCDIntfMock_Expect_WriteInstruction(lcdWriteInstruction);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_COMPLETE);
+    }
+};
+
+TEST(AnLCDDriver_Geometry, Addresses16x1RightHalfAsSecondLine) {
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDDriver_SetupGeometry(&lcd, &LCDGeometry_16x1));
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x07);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
+
+    LCDDriver_GotoXY(&lcd, 7, 0);
+    LCDDriver_GotoXY(&lcd, 8, 0);
+}
+
+TEST(AnLCDDriver_Geometry, Addresses16x4LowerRowsFrom0x10) {
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_16x4);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x10);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x5F);
+
+    LCDDriver_GotoXY(&lcd, 0, 2);
+    LCDDriver_GotoXY(&lcd, 15, 3);
+}
+
+TEST(AnLCDDriver_Geometry, Addresses20x4LowerRowsFrom0x14) {
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_20x4);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x14);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x54);
+
+    LCDDriver_GotoXY(&lcd, 0, 2);
+    LCDDriver_GotoXY(&lcd, 0, 3);
+}
+
+TEST(AnLCDDriver_Geometry, TakesScreenSizeFromGeometry) {
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_24x2);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x57);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
+
+    LCDDriver_GotoXY(&lcd, 23, 1);
+    LCDDriver_GotoXY(&lcd, 24, 1);
+}
+
+TEST(AnLCDDriver_Geometry, NeedsSecondControllerFor40x4) {
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED,
+        LCDDriver_SetupGeometry(&lcd, &LCDGeometry_40x4));
+}
+
+TEST(AnLCDDriver_Geometry, FlushesEachSegmentInBurstOfItsOwn) {
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_16x1);
+    LCDDriver_EnableShadow(&lcd);
+    LCDDriver_Puts(&lcd, (int8_t*)"0123456789ABCDEF");
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x00);
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("01234567", LCD_OPERATION_OK);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("89ABCDEF", LCD_OPERATION_OK);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Flush(&lcd));
+}
+
+TEST(AnLCDDriver_Geometry, LoadsEachSegmentFromItsAddress) {
+    static const LCDGeometry twoByOne = { 2, 1, 1, 1, { 0x00, 0x40 } };
+
+    LCDDriver_SetupGeometry(&lcd, &twoByOne);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x00);
+    LCDIntfMock_Expect_ReadDataThenReturn('a');
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_COMPLETE);
+    Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | 0x40);
+    LCDIntfMock_Expect_ReadDataThenReturn('b');
+    LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_COMPLETE);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_LoadShadow(&lcd));
+    MEMCMP_EQUAL("ab", lcd.shadowCells, 2);
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDDriver_Marquee, LCDDriver_PutX)
+{
+    void setup() override {
+        LCDDriverTest::setup();
+        LCDDriver_SetupGeometry(&lcd, &LCDGeometry_16x2);
+    }
+    void Expect_Command_Sequence(int32_t lcdWriteInstruction,
+            int32_t status = LCD_OPERATION_OK) {
+        LCDIntfMock_Expect_WriteInstruction(lcdWriteInstruction);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(status);
+    }
+    void Expect_Line_Load(int32_t addr, const char * text) {
+        char line[40 + 1];
+
+        memset(line, ' ', 40);
+        memcpy(line, text, strlen(text));
+        line[40] = '\0';
+        Expect_Command_Sequence(SET_DDRAM_ADDRESS_CMD | addr);
+        LCDIntfMock_Expect_WriteDataBurstThenReturn(line, LCD_OPERATION_OK);
+    }
+    int32_t start(const char * text) {
+        return LCDDriver_StartMarquee(&lcd, 1, (const int8_t*)text);
+    }
+};
+
+TEST(AnLCDDriver_Marquee, LoadsWholeLineOfTheRowAtStart) {
+    Expect_Command_Sequence(RETURN_HOME);
+    Expect_Line_Load(0x40, "news");
+
+    LONGS_EQUAL(LCD_OPERATION_OK, start("news"));
+}
+
+TEST(AnLCDDriver_Marquee, StepsWithSingleDisplayShift) {
+    Expect_Command_Sequence(RETURN_HOME);
+    Expect_Line_Load(0x40, "news");
+    Expect_Command_Sequence(DISPLAY_SHIFT__LEFT);
+
+    start("news");
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_StepMarquee(&lcd));
+}
+
+TEST(AnLCDDriver_Marquee, NeedsStartBeforeStep) {
+    LONGS_EQUAL(LCD_OPERATION_NOT_CONFIGURED, LCDDriver_StepMarquee(&lcd));
+}
+
+TEST(AnLCDDriver_Marquee, StopsAfterFailedStep) {
+    Expect_Command_Sequence(RETURN_HOME);
+    Expect_Line_Load(0x40, "news");
+    Expect_Command_Sequence(DISPLAY_SHIFT__LEFT, LCD_OPERATION_TIMEOUT);
+
+    start("news");
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDDriver_StepMarquee(&lcd));
+    LCDDriver_ClearFault(&lcd);
+    LONGS_EQUAL(LCD_OPERATION_NOT_CONFIGURED, LCDDriver_StepMarquee(&lcd));
+}
+
+TEST(AnLCDDriver_Marquee, ShiftsDisplayHomeWhenStopped) {
+    Expect_Command_Sequence(RETURN_HOME);
+    Expect_Line_Load(0x40, "news");
+    Expect_Command_Sequence(RETURN_HOME);
+
+    start("news");
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_StopMarquee(&lcd));
+    LCDDriver_GotoXY(&lcd, 0, 0);
+}
+
+TEST(AnLCDDriver_Marquee, NeedsHiddenColumns) {
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_40x2);
+
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, start("news"));
+}
+
+TEST(AnLCDDriver_Marquee, NeedsRowsOfTheirOwnLine) {
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_20x4);
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, start("news"));
+
+    LCDDriver_SetupGeometry(&lcd, &LCDGeometry_16x1);
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, start("news"));
+}
+
+TEST(AnLCDDriver_Marquee, IsNotForShadowMode) {
+    LCDDriver_EnableShadow(&lcd);
+
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, start("news"));
+    LCDDriver_DisableShadow(&lcd);
+}
+
+/* ====================================================================== */
+/*   A 40x4 module: rows 2-3 belong to a second controller.               */
+/* ====================================================================== */
+static LCDIntf lowerIntf;
+
+TEST_GROUP_BASE(AnLCDDriver_TwoControllers, LCDDriverTest)
+{
+    void setup() override {
+        LCDDriverTest::setup();
+        LONGS_EQUAL(LCD_OPERATION_OK,
+            LCDDriver_AddController(&lcd, &lowerIntf));
+        LCDDriver_SetupScreenDimensions(&lcd, 40, 4);
+        LCDIntfMock_TellApart(&intf);
+        LCDIntfMock_TellApart(&lowerIntf);
+    }
+    void Expect_Command_Sequence(LCDIntf * on, int32_t lcdWriteInstruction,
+            int32_t status = LCDINTFMOCK_WAIT_COMPLETE) {
+        LCDIntfMock_ExpectOn(on);
+        LCDIntfMock_Expect_WriteInstruction(lcdWriteInstruction);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(status);
+    }
+    void Expect_Status_Read(LCDIntf * on, int32_t status) {
+        LCDIntfMock_ExpectOn(on);
+        LCDIntfMock_Expect_ReadInstructionThenReturn(status);
+    }
+    void Expect_Wait(LCDIntf * on,
+            int32_t status = LCDINTFMOCK_WAIT_COMPLETE) {
+        LCDIntfMock_ExpectOn(on);
+        LCDIntfMock_Expect_WaitWhileBusyThenReturn(status);
+    }
+    void FaultLowerController() {
+        LCDIntfMock_Microseconds = 0;
+        Expect_Command_Sequence(&lowerIntf, SET_DDRAM_ADDRESS_CMD,
+            LCDINTFMOCK_WAIT_TIMEOUT);
+        LCDDriver_GotoXY(&lcd, 0, 2);
+        LCDIntfMock_Microseconds += LCDDRIVER_FAULT_BACKOFF_US;
+    }
+};
+
+TEST(AnLCDDriver_TwoControllers, TakesNoThirdController) {
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED,
+        LCDDriver_AddController(&lcd, &lowerIntf));
+}
+
+TEST(AnLCDDriver_TwoControllers, AddressesThirdRowFromTheTop) {
+    Expect_Command_Sequence(&lowerIntf, SET_DDRAM_ADDRESS_CMD | 0x05);
+
+    LCDDriver_GotoXY(&lcd, 5, 2);
+}
+
+TEST(AnLCDDriver_TwoControllers, AddressesFourthRowAsSecondLine) {
+    Expect_Command_Sequence(&lowerIntf, SET_DDRAM_ADDRESS_CMD | 0x67);
+
+    LCDDriver_GotoXY(&lcd, 39, 3);
+}
+
+TEST(AnLCDDriver_TwoControllers, KeepsAddressOfEveryControllerApart) {
+    Expect_Command_Sequence(&intf, SET_DDRAM_ADDRESS_CMD | 0x05);
+    Expect_Command_Sequence(&lowerIntf, SET_DDRAM_ADDRESS_CMD | 0x05);
+
+    LCDDriver_GotoXY(&lcd, 5, 0);
+    LCDDriver_GotoXY(&lcd, 5, 2);
+    LCDDriver_GotoXY(&lcd, 5, 0);
+}
+
+TEST(AnLCDDriver_TwoControllers, ClearsBothBeforeWaitingForEither) {
+    LCDIntfMock_ExpectOn(&intf);
+    LCDIntfMock_Expect_WriteInstruction(DISPLAY_CLEAR);
+    LCDIntfMock_ExpectOn(&lowerIntf);
+    LCDIntfMock_Expect_WriteInstruction(DISPLAY_CLEAR);
+    Expect_Wait(&intf);
+    Expect_Wait(&lowerIntf, LCDINTFMOCK_WAIT_TIMEOUT);
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDDriver_Clear(&lcd));
+}
+
+TEST(AnLCDDriver_TwoControllers, ReprobesEveryControllerAfterFault) {
+    FaultLowerController();
+    Expect_Status_Read(&intf, READ_INSTRUCTION__NO_BUSY_FLAG);
+    Expect_Status_Read(&lowerIntf, READ_INSTRUCTION__BUSY_FLAG);
+
+    LONGS_EQUAL(LCD_OPERATION_FAULT, LCDDriver_GotoXY(&lcd, 0, 0));
+}
+
+TEST(AnLCDDriver_TwoControllers, RecoversWhenEveryControllerAnswers) {
+    FaultLowerController();
+    Expect_Status_Read(&intf, READ_INSTRUCTION__NO_BUSY_FLAG);
+    Expect_Status_Read(&lowerIntf, READ_INSTRUCTION__NO_BUSY_FLAG);
+    Expect_Command_Sequence(&intf, SET_DDRAM_ADDRESS_CMD);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_GotoXY(&lcd, 0, 0));
+}
+
+TEST(AnLCDDriver_TwoControllers, FlushesControllersInTurns) {
+    static const LCDGeometry twoByFour = { 2, 4, 2, 2,
+        { 0x00, 0x40, 0x00, 0x40 } };
+
+    LCDDriver_SetupGeometry(&lcd, &twoByFour);
+    LCDDriver_EnableShadow(&lcd);
+    LCDDriver_GotoXY(&lcd, 0, 0);
+    LCDDriver_Putc(&lcd, 'a');
+    LCDDriver_Putc(&lcd, 'b');
+    LCDDriver_GotoXY(&lcd, 0, 2);
+    LCDDriver_Putc(&lcd, 'c');
+    LCDDriver_Putc(&lcd, 'd');
+    LCDIntf * both[] = { &intf, &lowerIntf };
+    for (int c = 0; c < 2; ++c) {
+        Expect_Wait(both[c]);
+        LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD);
+    }
+    for (int i = 0; i < 2; ++i) {
+        Expect_Wait(&intf);
+        LCDIntfMock_Expect_WriteData("ab"[i]);
+        Expect_Wait(&lowerIntf);
+        LCDIntfMock_Expect_WriteData("cd"[i]);
+    }
+    // the second rows are blank, yet dirty: the screen was never flushed
+    for (int c = 0; c < 2; ++c) {
+        Expect_Wait(both[c]);
+        LCDIntfMock_Expect_WriteInstruction(SET_DDRAM_ADDRESS_CMD | 0x40);
+    }
+    for (int i = 0; i < 2 * 2; ++i) {
+        Expect_Wait(both[i & 0x01]);
+        LCDIntfMock_Expect_WriteData(' ');
+    }
+    for (int c = 0; c < 2; ++c)
+        Expect_Wait(both[c]);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Flush(&lcd));
+}
@@ -5,37 +5,114 @@ extern "C" {
 };
 #include "LCDIntfMock.h"
 
-// extern "C" int32_t LCDIntf_Init(int32_t lcdPortDataWidth) { }
-// extern "C" void    LCDIntf_Deinit(void) { }
-// extern "C" int32_t LCDIntf_GetPortDataWidth(void) { }
-// extern "C" int32_t LCDIntf_InitializeLCDController(void) { }
+// extern "C" int32_t LCDIntf_Init(LCDIntf * intf, ...) { }
+// extern "C" void    LCDIntf_Deinit(LCDIntf * intf) { }
+// extern "C" int32_t LCDIntf_GetPortDataWidth(LCDIntf * intf) { }
+// extern "C" int32_t LCDIntf_InitializeLCDController(LCDIntf * intf) { }
+
+uint32_t LCDIntfMock_Microseconds = 0;
+
+static LCDIntf * toldApart[LCDINTFMOCK_MAX_INTFS];
+static int32_t expectedOn = 0;
+
+static int32_t
+numberOf(const LCDIntf * intf)
+{
+    for (int32_t i = 1; i < LCDINTFMOCK_MAX_INTFS; ++i)
+        if (toldApart[i] == intf)
+            return i;
+    return 0;
+}
+
+static int32_t
+callOn(const LCDIntf * intf, int32_t call)
+{
+    return call | (numberOf(intf) << LCDINTFMOCK_INTF_SHIFT);
+}
+
+void
+LCDIntfMock_Reset(void)
+{
+    for (int32_t i = 0; i < LCDINTFMOCK_MAX_INTFS; ++i)
+        toldApart[i] = NULL;
+    expectedOn = 0;
+}
+
+void
+LCDIntfMock_TellApart(LCDIntf * intf)
+{
+    for (int32_t i = 1; i < LCDINTFMOCK_MAX_INTFS; ++i) {
+        if (NULL == toldApart[i]) {
+            toldApart[i] = intf;
+            return;
+        }
+    }
+}
+
+void
+LCDIntfMock_ExpectOn(LCDIntf * intf)
+{
+    expectedOn = numberOf(intf);
+}
+
+int32_t
+LCDIntfMock_ExpectedCall(int32_t call)
+{
+    return call | (expectedOn << LCDINTFMOCK_INTF_SHIFT);
+}
+
+extern "C" uint32_t
+Timestamp_microseconds(void)
+{
+    return LCDIntfMock_Microseconds;
+}
 
 extern "C" void
-LCDIntf_WriteInstruction(int32_t i)
+LCDIntf_WriteInstruction(LCDIntf * intf, int32_t i)
 {
-    MockPeriphIO_Write(LCDINTFMOCK_WRITE_INSTRUCTION_CALL, i);
+    MockPeriphIO_Write(callOn(intf, LCDINTFMOCK_WRITE_INSTRUCTION_CALL), i);
 }
 
 extern "C" void
-LCDIntf_WriteData(int32_t d)
+LCDIntf_WriteData(LCDIntf * intf, int32_t d)
+{
+    MockPeriphIO_Write(callOn(intf, LCDINTFMOCK_WRITE_DATA_CALL), d);
+}
+
+extern "C" int32_t
+LCDIntf_ReadData(LCDIntf * intf)
+{
+    return MockPeriphIO_Read(callOn(intf, LCDINTFMOCK_READ_DATA_CALL));
+}
+
+extern "C" int32_t
+LCDIntf_ReadInstruction(LCDIntf * intf)
 {
-    MockPeriphIO_Write(LCDINTFMOCK_WRITE_DATA_CALL, d);
+    return MockPeriphIO_Read(callOn(intf, LCDINTFMOCK_READ_INSTRUCTION_CALL));
 }
 
 extern "C" int32_t
-LCDIntf_ReadData(void)
+LCDIntf_WaitWhileBusy(LCDIntf * intf)
 {
-    return MockPeriphIO_Read(LCDINTFMOCK_READ_DATA_CALL);
+    return MockPeriphIO_Read(callOn(intf, LCDINTFMOCK_WAIT_WHILE_BUSY_CALL));
 }
 
 extern "C" int32_t
-LCDIntf_ReadInstruction(void)
+LCDIntf_WriteInstructionBurst(LCDIntf * intf, const uint8_t * buf, size_t n)
 {
-    return MockPeriphIO_Read(LCDINTFMOCK_READ_INSTRUCTION_CALL);
+    int32_t call = callOn(intf, LCDINTFMOCK_WRITE_INSTRUCTION_BURST_CALL);
+
+    for (size_t i = 0; i < n; ++i)
+        MockPeriphIO_Write(call, buf[i]);
+    return MockPeriphIO_Read(call);
 }
 
 extern "C" int32_t
-LCDIntf_WaitWhileBusy(void)
+LCDIntf_WriteDataBurst(LCDIntf * intf, const uint8_t * buf, size_t n)
 {
-    return MockPeriphIO_Read(LCDINTFMOCK_WAIT_WHILE_BUSY_CALL);
+    int32_t call = callOn(intf, LCDINTFMOCK_WRITE_DATA_BURST_CALL);
+
+    for (size_t i = 0; i < n; ++i)
+        MockPeriphIO_Write(call, buf[i]);
+    return MockPeriphIO_Read(call);
 }
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 extern "C" {
+#include "LCDIntf.h"
 #include "MockPeriphIO.h"
 };
 
@@ -12,40 +13,93 @@ enum {
     LCDINTFMOCK_READ_INSTRUCTION_CALL,
     LCDINTFMOCK_READ_DATA_CALL,
     LCDINTFMOCK_WAIT_WHILE_BUSY_CALL,
-    LCDINTFMOCK_WAIT_COMPLETE,
-    LCDINTFMOCK_WAIT_TIMEOUT,
+    LCDINTFMOCK_WRITE_INSTRUCTION_BURST_CALL,
+    LCDINTFMOCK_WRITE_DATA_BURST_CALL,
 };
 
+// the driver acts upon these, thus they have to be real status codes
+enum {
+    LCDINTFMOCK_WAIT_COMPLETE = LCD_OPERATION_OK,
+    LCDINTFMOCK_WAIT_TIMEOUT  = LCD_OPERATION_TIMEOUT,
+};
+
+// the clock Timestamp_microseconds() reads
+extern uint32_t LCDIntfMock_Microseconds;
+
+/*   Calls on the interfaces told apart are recorded with the number of the
+ * interface (1, 2, ...) on top of the call code; the expectations made
+ * after LCDIntfMock_ExpectOn() carry the number of that interface.  Any
+ * other interface is number 0, as are all of them until told apart.
+ */
+enum {
+    LCDINTFMOCK_MAX_INTFS = 4,
+    LCDINTFMOCK_INTF_SHIFT = 8,
+};
+
+void    LCDIntfMock_Reset(void);
+void    LCDIntfMock_TellApart(LCDIntf * intf);
+void    LCDIntfMock_ExpectOn(LCDIntf * intf);
+int32_t LCDIntfMock_ExpectedCall(int32_t call);
+
 inline void
 LCDIntfMock_Expect_WriteInstruction(int32_t i)
 {
-    MockPeriphIO_Expect_Write(LCDINTFMOCK_WRITE_INSTRUCTION_CALL, i);
+    MockPeriphIO_Expect_Write(
+        LCDIntfMock_ExpectedCall(LCDINTFMOCK_WRITE_INSTRUCTION_CALL), i);
 }
 
 inline void
 LCDIntfMock_Expect_WriteData(int32_t d)
 {
-    MockPeriphIO_Expect_Write(LCDINTFMOCK_WRITE_DATA_CALL, d);
+    MockPeriphIO_Expect_Write(
+        LCDIntfMock_ExpectedCall(LCDINTFMOCK_WRITE_DATA_CALL), d);
 }
 
 inline void
 LCDIntfMock_Expect_ReadDataThenReturn(int32_t retVal)
 {
-    MockPeriphIO_Expect_ReadThenReturn(LCDINTFMOCK_READ_DATA_CALL, retVal);
+    MockPeriphIO_Expect_ReadThenReturn(
+        LCDIntfMock_ExpectedCall(LCDINTFMOCK_READ_DATA_CALL), retVal);
 }
 
 inline void
 LCDIntfMock_Expect_ReadInstructionThenReturn(int32_t retVal)
 {
-    MockPeriphIO_Expect_ReadThenReturn(LCDINTFMOCK_READ_INSTRUCTION_CALL,
-        retVal);
+    MockPeriphIO_Expect_ReadThenReturn(
+        LCDIntfMock_ExpectedCall(LCDINTFMOCK_READ_INSTRUCTION_CALL), retVal);
 }
 
 inline void
 LCDIntfMock_Expect_WaitWhileBusyThenReturn(int32_t retVal)
 {
-    MockPeriphIO_Expect_ReadThenReturn(LCDINTFMOCK_WAIT_WHILE_BUSY_CALL,
-        retVal);
+    MockPeriphIO_Expect_ReadThenReturn(
+        LCDIntfMock_ExpectedCall(LCDINTFMOCK_WAIT_WHILE_BUSY_CALL), retVal);
+}
+
+/*   A burst is recorded as a write per byte followed by a read of the
+ * status it returns.
+ */
+inline void
+LCDIntfMock_Expect_WriteInstructionBurstThenReturn(const uint8_t * buf,
+        int32_t n, int32_t retVal)
+{
+    int32_t call =
+        LCDIntfMock_ExpectedCall(LCDINTFMOCK_WRITE_INSTRUCTION_BURST_CALL);
+
+    for (int32_t i = 0; i < n; ++i)
+        MockPeriphIO_Expect_Write(call, buf[i]);
+    MockPeriphIO_Expect_ReadThenReturn(call, retVal);
+}
+
+inline void
+LCDIntfMock_Expect_WriteDataBurstThenReturn(const char * str,
+        int32_t retVal)
+{
+    int32_t call = LCDIntfMock_ExpectedCall(LCDINTFMOCK_WRITE_DATA_BURST_CALL);
+
+    for (; *str; ++str)
+        MockPeriphIO_Expect_Write(call, (uint8_t)*str);
+    MockPeriphIO_Expect_ReadThenReturn(call, retVal);
 }
 
 #endif /* #ifndef D_LCDIntfMock_h */
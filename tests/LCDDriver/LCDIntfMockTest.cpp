@@ -7,12 +7,15 @@ extern "C"
 };
 #include "LCDIntfMock.h"
 
+static LCDIntf intf;
+
 TEST_GROUP(AnLCDMock)
 {
     int32_t anyValue, expectedValue;
 
     void setup() override {
         MockPeriphIO_Create(5);
+        LCDIntfMock_Reset();
     }
     void teardown() override {
         MockPeriphIO_Verify_Complete();
@@ -24,35 +27,65 @@ TEST(AnLCDMock, InterceptsWriteInstructionCalls) {
     anyValue = 0x1234;
     LCDIntfMock_Expect_WriteInstruction(anyValue);
 
-    LCDIntf_WriteInstruction(anyValue);
+    LCDIntf_WriteInstruction(&intf, anyValue);
 }
 
 TEST(AnLCDMock, InterceptsWriteDataCalls) {
     anyValue = 0x1238;
     LCDIntfMock_Expect_WriteData(anyValue);
 
-    LCDIntf_WriteData(anyValue);
+    LCDIntf_WriteData(&intf, anyValue);
 }
 
 TEST(AnLCDMock, ControlsReadDataCalls) {
     expectedValue = 0x2020;
     LCDIntfMock_Expect_ReadDataThenReturn(expectedValue);
 
-    LONGS_EQUAL(expectedValue, LCDIntf_ReadData());
+    LONGS_EQUAL(expectedValue, LCDIntf_ReadData(&intf));
 }
 
 TEST(AnLCDMock, ControlsReadInstructionCalls) {
     expectedValue = 0x2024;
     LCDIntfMock_Expect_ReadInstructionThenReturn(expectedValue);
 
-    LONGS_EQUAL(expectedValue, LCDIntf_ReadInstruction());
+    LONGS_EQUAL(expectedValue, LCDIntf_ReadInstruction(&intf));
 }
 
 TEST(AnLCDMock, InterceptsWaitWhileBusyCalls) {
     LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_TIMEOUT);
     LCDIntfMock_Expect_WaitWhileBusyThenReturn(LCDINTFMOCK_WAIT_COMPLETE);
 
-    LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT,  LCDIntf_WaitWhileBusy());
-    LONGS_EQUAL(LCDINTFMOCK_WAIT_COMPLETE, LCDIntf_WaitWhileBusy());
+    LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT,  LCDIntf_WaitWhileBusy(&intf));
+    LONGS_EQUAL(LCDINTFMOCK_WAIT_COMPLETE, LCDIntf_WaitWhileBusy(&intf));
+}
+
+TEST(AnLCDMock, InterceptsWriteInstructionBurstCalls) {
+    const uint8_t burst[] = { 0x01, 0x80 };
+    LCDIntfMock_Expect_WriteInstructionBurstThenReturn(burst, 2,
+        LCDINTFMOCK_WAIT_COMPLETE);
+
+    LONGS_EQUAL(LCDINTFMOCK_WAIT_COMPLETE,
+        LCDIntf_WriteInstructionBurst(&intf, burst, 2));
+}
+
+TEST(AnLCDMock, TellsInterfacesApart) {
+    LCDIntf other;
+
+    LCDIntfMock_TellApart(&intf);
+    LCDIntfMock_TellApart(&other);
+    LCDIntfMock_ExpectOn(&other);
+    LCDIntfMock_Expect_WriteData('o');
+    LCDIntfMock_ExpectOn(&intf);
+    LCDIntfMock_Expect_WriteData('i');
+
+    LCDIntf_WriteData(&other, 'o');
+    LCDIntf_WriteData(&intf, 'i');
 }
 
+TEST(AnLCDMock, InterceptsWriteDataBurstCalls) {
+    LCDIntfMock_Expect_WriteDataBurstThenReturn("ab",
+        LCDINTFMOCK_WAIT_TIMEOUT);
+
+    LONGS_EQUAL(LCDINTFMOCK_WAIT_TIMEOUT,
+        LCDIntf_WriteDataBurst(&intf, (const uint8_t *)"ab", 2));
+}
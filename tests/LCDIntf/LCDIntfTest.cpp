@@ -8,6 +8,7 @@ extern "C"
 };
 #include "LCDPortSpy.h"
 #include <stdio.h>
+#include <string.h>
 
 #define HI_NIB(byte) ((byte >> 4) & 0x0F)
 #define LO_NIB(byte) (byte & 0x0F)
@@ -29,10 +30,31 @@ Delay_microseconds(uint32_t microseconds)
 }
 
 /* ====================================================================== */
+/*   Time is read far too often to be a mocked I/O: tests just set it.    */
+/* ====================================================================== */
+static uint32_t fakeMicroseconds = 0;
+static uint32_t fakeClockTick = 0;
+
+// ticking, the clock lets a busy flag poll run out of its budget
+extern "C" uint32_t
+Timestamp_microseconds(void)
+{
+    uint32_t now = fakeMicroseconds;
+
+    fakeMicroseconds += fakeClockTick;
+    return now;
+}
+
+/* ====================================================================== */
+static LCDIntf intf;
+
 TEST_GROUP(AnLCDIntf_InitAndDestroy)
 {
     void setup() override {
+        // zeroed storage is an instance that has never been initialized
+        memset(&intf, 0, sizeof(intf));
         LCDPortSpy_ResetToDefaultState();
+        fakeClockTick = 0;
     }
 };
 
@@ -41,41 +63,56 @@ TEST(AnLCDIntf_InitAndDestroy, LCDPortIsNotInitializedOnStartup) {
 }
 
 TEST(AnLCDIntf_InitAndDestroy, InitializationPropagatesToLCDPort) {
-    LCDIntf_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
 
     LONGS_EQUAL(LINE_STATE_DEASSERTED, LCDPortSpy_GetCE());
 }
 
 TEST(AnLCDIntf_InitAndDestroy, InitSetsPortDataWidthTo8Bits) {
-    LCDIntf_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
 
-    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_8_BIT, LCDIntf_GetPortDataWidth());
+    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_8_BIT, LCDIntf_GetPortDataWidth(&intf));
 }
 
 TEST(AnLCDIntf_InitAndDestroy, DeinitializationPropagatesToLCDPort) {
-    LCDIntf_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
 
-    LCDIntf_Deinit();
+    LCDIntf_Deinit(&intf);
 
     LONGS_EQUAL(LINE_STATE_UNDEFINED, LCDPortSpy_GetCE());
 }
 
 TEST(AnLCDIntf_InitAndDestroy, DeinitUndefinesPortDataWidth) {
-    LCDIntf_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
 
-    LCDIntf_Deinit();
+    LCDIntf_Deinit(&intf);
 
-    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_UNDEFINED, LCDIntf_GetPortDataWidth());
+    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_UNDEFINED,
+        LCDIntf_GetPortDataWidth(&intf));
+}
+
+TEST(AnLCDIntf_InitAndDestroy, DeinitRestoresBusyFlagPolling) {
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_PREDICT);
+
+    LCDIntf_Deinit(&intf);
+
+    LONGS_EQUAL(LCD_BUSY_MODE_POLL, LCDIntf_GetBusyMode(&intf));
+}
+
+TEST(AnLCDIntf_InitAndDestroy, CannotStartControllerInitBeforeInit) {
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED,
+        LCDIntf_StartLCDControllerInit(&intf));
 }
 
 TEST(AnLCDIntf_InitAndDestroy, InitCanSetPortDataWidthTo4Bits) {
-    LCDIntf_Init(LCD_PORT_DATA_WIDTH_4_BIT);
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_4_BIT);
 
-    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_4_BIT, LCDIntf_GetPortDataWidth());
+    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_4_BIT, LCDIntf_GetPortDataWidth(&intf));
 }
 
 /* ====================================================================== */
-struct LCDIntf : public Utest
+struct LCDIntfTest : public Utest
 {
     void Expect_SetRS() {
         MockPeriphIO_Expect_Write(LCD_RS_ADDR, LINE_STATE_ASSERTED);
@@ -106,7 +143,7 @@ struct LCDIntf : public Utest
     }
 };
 
-struct LCDIntf_11Wires : public LCDIntf
+struct LCDIntf_11Wires : public LCDIntfTest
 {
     void Expect_GetData8ThenReturn(int32_t data) {
         MockPeriphIO_Expect_ReadThenReturn(LCD_DATA8_ADDR, data);
@@ -125,19 +162,84 @@ struct LCDIntf_11Wires : public LCDIntf
         MockPeriphIO_Expect_Write(LCD_FAKE_DIRECTION8_REG,
             LCD_PORT_DATA_DIR_OUTPUT8);
     }
+
+    /*   Data lines stay driven after a write until a read needs them; the
+     * sequences below follow that.
+     */
+    bool dataLinesDriven = false;
+
+    void ExpectSequence_Write(int32_t rs, int32_t value) {
+        if (rs)
+            Expect_SetRS();
+        else
+            Expect_ClearRS();
+        if (!dataLinesDriven)
+            Expect_ClearRW();
+        Expect_SetCE();
+        Expect_PutData8(value);
+        if (!dataLinesDriven)
+            Expect_SetDirection_Out8();
+        Expect_ClearCE();
+        dataLinesDriven = true;
+    }
+
+    void ExpectSequence_WriteInstruction(int32_t instr) {
+        ExpectSequence_Write(0, instr);
+    }
+
+    void ExpectSequence_WriteData(int32_t data) {
+        ExpectSequence_Write(1, data);
+    }
+
+    void ExpectSequence_ReleaseDataLines() {
+        if (dataLinesDriven)
+            Expect_SetDirection_In8();
+        dataLinesDriven = false;
+    }
+
+    void ExpectSequence_ReadBusyFlag(int32_t retVal) {
+        ExpectSequence_ReleaseDataLines();
+        Expect_ClearRS();
+        Expect_SetRW();
+        Expect_SetCE();
+        Expect_GetData8ThenReturn(retVal);
+        Expect_ClearCE();
+    }
+
+    void ExpectSequence_ReadData(int32_t retVal) {
+        ExpectSequence_ReleaseDataLines();
+        Expect_SetRS();
+        Expect_SetRW();
+        Expect_SetCE();
+        Expect_GetData8ThenReturn(retVal);
+        Expect_ClearCE();
+    }
+
+    void ExpectSequence_ReadBusyFlagUntilTimeout(
+            uint32_t budget = LCD_BUSY_TIMEOUT_SHORT_US) {
+        fakeClockTick = 1;
+        ExpectSequence_ReleaseDataLines();
+        Expect_ClearRS();
+        Expect_SetRW();
+        Expect_SetCE();
+        for (uint32_t i = 0; i < budget; ++i)
+            Expect_GetData8ThenReturn(READ_INSTRUCTION__BUSY_FLAG);
+        Expect_ClearCE();
+    }
 };
 
 /* ====================================================================== */
 TEST_GROUP_BASE(AnLCDIntf_11Wires, LCDIntf_11Wires)
 {
     void setup() override {
-        MockPeriphIO_Create(10);
+        MockPeriphIO_Create(30);
         LCDPortSpy_ResetToDefaultState();
-        LCDIntf_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
     }
 
     void teardown() override {
-        LCDIntf_Deinit();
+        LCDIntf_Deinit(&intf);
         MockPeriphIO_Verify_Complete();
         MockPeriphIO_Destroy();
     }
@@ -150,10 +252,8 @@ TEST(AnLCDIntf_11Wires, WritesInstruction) {
     Expect_PutData8(0x5A);
     Expect_SetDirection_Out8();
     Expect_ClearCE();
-    Expect_SetDirection_In8();
-    Expect_SetRW();
     
-    LCDIntf_WriteInstruction(0x5A);
+    LCDIntf_WriteInstruction(&intf, 0x5A);
 }
 
 TEST(AnLCDIntf_11Wires, WritesData) {
@@ -163,10 +263,36 @@ TEST(AnLCDIntf_11Wires, WritesData) {
     Expect_PutData8(0xA5);
     Expect_SetDirection_Out8();
     Expect_ClearCE();
-    Expect_SetDirection_In8();
-    Expect_SetRW();
 
-    LCDIntf_WriteData(0xA5);
+    LCDIntf_WriteData(&intf, 0xA5);
+}
+
+TEST(AnLCDIntf_11Wires, KeepsDataLinesDrivenAcrossWrites) {
+    Expect_SetRS();
+    Expect_ClearRW();
+    Expect_SetCE();
+    Expect_PutData8('a');
+    Expect_SetDirection_Out8();
+    Expect_ClearCE();
+    Expect_SetRS();
+    Expect_SetCE();
+    Expect_PutData8('b');
+    Expect_ClearCE();
+
+    LCDIntf_WriteData(&intf, 'a');
+    LCDIntf_WriteData(&intf, 'b');
+}
+
+TEST(AnLCDIntf_11Wires, DrivesDataLinesAgainAfterRead) {
+    ExpectSequence_WriteData('a');
+    ExpectSequence_WriteData('b');
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+    ExpectSequence_WriteData('c');
+
+    LCDIntf_WriteData(&intf, 'a');
+    LCDIntf_WriteData(&intf, 'b');
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+    LCDIntf_WriteData(&intf, 'c');
 }
 
 TEST(AnLCDIntf_11Wires, ReadsData) {
@@ -176,7 +302,7 @@ TEST(AnLCDIntf_11Wires, ReadsData) {
     Expect_GetData8ThenReturn(0x77);
     Expect_ClearCE();
 
-    LONGS_EQUAL(0x77, LCDIntf_ReadData());
+    LONGS_EQUAL(0x77, LCDIntf_ReadData(&intf));
 }
 
 TEST(AnLCDIntf_11Wires, ReadsBusyFlagAndAddress) {
@@ -186,7 +312,7 @@ TEST(AnLCDIntf_11Wires, ReadsBusyFlagAndAddress) {
     Expect_GetData8ThenReturn(0x87);
     Expect_ClearCE();
 
-    LONGS_EQUAL(0x87, LCDIntf_ReadInstruction());
+    LONGS_EQUAL(0x87, LCDIntf_ReadInstruction(&intf));
 }
 
 TEST(AnLCDIntf_11Wires, WaitForBusyFlag_ReadyImmediately) {
@@ -196,7 +322,7 @@ TEST(AnLCDIntf_11Wires, WaitForBusyFlag_ReadyImmediately) {
     Expect_GetData8ThenReturn(READ_INSTRUCTION__NO_BUSY_FLAG);
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_OK, status);
 }
@@ -210,7 +336,7 @@ TEST(AnLCDIntf_11Wires, WaitForBusyFlag_NotImmediatelyReady) {
     Expect_GetData8ThenReturn(READ_INSTRUCTION__NO_BUSY_FLAG);
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_OK, status);
 }
@@ -227,58 +353,500 @@ TEST(AnLCDIntf_11Wires, WaitForBusyFlag_ActsUponBusyFlagOnly) {
     Expect_GetData8ThenReturn(noBusyFlagButAddr);
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_OK, status);
 }
 
 TEST(AnLCDIntf_11Wires, WaitForBusyFlag_ReadTimeout) {
+    fakeClockTick = 1;
     Expect_ClearRS();
     Expect_SetRW();
     Expect_SetCE();
-    for (int i = 0; i < BUSY_FLAG_READS_BEFORE_GIVING_UP; ++i) 
+    for (int i = 0; i < LCD_BUSY_TIMEOUT_SHORT_US; ++i)
         Expect_GetData8ThenReturn(READ_INSTRUCTION__BUSY_FLAG);
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_TIMEOUT, status);
 }
 
+TEST(AnLCDIntf_11Wires, GivesClearLongBusyBudget) {
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_ReadBusyFlagUntilTimeout(LCD_BUSY_TIMEOUT_LONG_US);
+
+    LCDIntf_WriteInstruction(&intf, DISPLAY_CLEAR);
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_WaitWhileBusy(&intf));
+}
+
+TEST(AnLCDIntf_11Wires, GivesDataShortBusyBudget) {
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+    ExpectSequence_WriteData('a');
+    ExpectSequence_ReadBusyFlagUntilTimeout(LCD_BUSY_TIMEOUT_SHORT_US);
+
+    LCDIntf_WriteInstruction(&intf, DISPLAY_CLEAR);
+    LCDIntf_WaitWhileBusy(&intf);
+    LCDIntf_WriteData(&intf, 'a');
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_WaitWhileBusy(&intf));
+}
+
+TEST(AnLCDIntf_11Wires, PollsBusyFlagBetweenBytesOfBurst) {
+    const uint8_t burst[] = { 'a', 'b' };
+
+    Expect_SetRS();
+    Expect_ClearRW();
+    Expect_SetDirection_Out8();
+    Expect_SetCE();
+    Expect_PutData8('a');
+    Expect_ClearCE();
+    dataLinesDriven = true;
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+    Expect_SetRS();
+    Expect_ClearRW();
+    Expect_SetDirection_Out8();
+    Expect_SetCE();
+    Expect_PutData8('b');
+    Expect_ClearCE();
+    dataLinesDriven = true;
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WriteDataBurst(&intf, burst, 2));
+}
+
+TEST(AnLCDIntf_11Wires, StopsBurstAtFirstTimeout) {
+    const uint8_t burst[] = { 'a', 'b' };
+
+    Expect_SetRS();
+    Expect_ClearRW();
+    Expect_SetDirection_Out8();
+    Expect_SetCE();
+    Expect_PutData8('a');
+    Expect_ClearCE();
+    dataLinesDriven = true;
+    ExpectSequence_ReadBusyFlagUntilTimeout();
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT,
+        LCDIntf_WriteDataBurst(&intf, burst, 2));
+}
+
 /* ====================================================================== */
-struct LCDControllerInit_11Wires : public LCDIntf_11Wires
+TEST_GROUP_BASE(AnLCDIntf_11Wires_PredictedBusy, LCDIntf_11Wires)
 {
-    void ExpectSequence_8BitWriteInstruction(int32_t cmd) {
+    void setup() override {
+        MockPeriphIO_Create(30);
+        LCDPortSpy_ResetToDefaultState();
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+        fakeMicroseconds = 1000;
+        LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_PREDICT);
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
+    }
+
+};
+
+TEST(AnLCDIntf_11Wires_PredictedBusy, WaitWhileBusyCostsNoBusCycles) {
+    ExpectSequence_WriteData('a');
+
+    LCDIntf_WriteData(&intf, 'a');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+}
+
+TEST(AnLCDIntf_11Wires_PredictedBusy, LateWriteNeedsNoBusyFlagRead) {
+    ExpectSequence_WriteData('a');
+    ExpectSequence_WriteData('b');
+
+    LCDIntf_WriteData(&intf, 'a');
+    fakeMicroseconds += LCD_EXECUTION_TIME_SHORT_US;
+    LCDIntf_WriteData(&intf, 'b');
+}
+
+TEST(AnLCDIntf_11Wires_PredictedBusy, EarlyWriteWaitsOutWithoutBusyFlagRead) {
+    ExpectSequence_WriteData('a');
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US - 10);
+    ExpectSequence_WriteData('b');
+
+    LCDIntf_WriteData(&intf, 'a');
+    fakeMicroseconds += 10;
+    LCDIntf_WriteData(&intf, 'b');
+}
+
+TEST(AnLCDIntf_11Wires_PredictedBusy, ClearTakesLongExecutionTime) {
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_LONG_US - 100);
+    ExpectSequence_WriteData('a');
+
+    LCDIntf_WriteInstruction(&intf, DISPLAY_CLEAR);
+    fakeMicroseconds += 100;
+    LCDIntf_WriteData(&intf, 'a');
+}
+
+TEST(AnLCDIntf_11Wires_PredictedBusy, BackToBackWritesKeepTheBusDriven) {
+    ExpectSequence_WriteData('a');
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    ExpectSequence_WriteData('b');
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    ExpectSequence_WriteData('c');
+
+    LCDIntf_WriteData(&intf, 'a');
+    LCDIntf_WriteData(&intf, 'b');
+    LCDIntf_WriteData(&intf, 'c');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+}
+
+/* ====================================================================== */
+/*   The yield hook plays the main loop: every call services a bit of
+ * other work, which takes OTHER_WORK_US of (fake) time.
+ */
+enum {
+    OTHER_WORK_US = 2,
+};
+
+static uint32_t otherWorkDone = 0;
+
+static void
+doOtherWork(void)
+{
+    ++otherWorkDone;
+    fakeMicroseconds += OTHER_WORK_US;
+}
+
+TEST_GROUP_BASE(AnLCDIntf_11Wires_Yield, LCDIntf_11Wires)
+{
+    void setup() override {
+        MockPeriphIO_Create(30);
+        LCDPortSpy_ResetToDefaultState();
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+        fakeMicroseconds = 1000;
+        otherWorkDone = 0;
+        LCDIntf_SetYieldHook(&intf, doOtherWork);
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
+    }
+};
+
+TEST(AnLCDIntf_11Wires_Yield, YieldsBetweenBusyFlagPolls) {
+    ExpectSequence_WriteInstruction(RETURN_HOME);
+    ExpectSequence_ReleaseDataLines();
+    Expect_ClearRS();
+    Expect_SetRW();
+    Expect_SetCE();
+    for (int i = 0; i < 3; ++i)
+        Expect_GetData8ThenReturn(READ_INSTRUCTION__BUSY_FLAG);
+    Expect_GetData8ThenReturn(READ_INSTRUCTION__NO_BUSY_FLAG);
+    Expect_ClearCE();
+
+    LCDIntf_WriteInstruction(&intf, RETURN_HOME);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+    LONGS_EQUAL(3, otherWorkDone);
+}
+
+TEST(AnLCDIntf_11Wires_Yield, DoesNotYieldToReadyController) {
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+
+    LCDIntf_WaitWhileBusy(&intf);
+
+    LONGS_EQUAL(0, otherWorkDone);
+}
+
+TEST(AnLCDIntf_11Wires_Yield, OtherWorkProgressesDuringPredictedClear) {
+    LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_PREDICT);
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_WriteData('a');
+
+    LCDIntf_WriteInstruction(&intf, DISPLAY_CLEAR);
+    LCDIntf_WriteData(&intf, 'a');
+
+    // no Delay_microseconds(): the clear is waited out by the main loop
+    LONGS_EQUAL((LCD_EXECUTION_TIME_LONG_US + OTHER_WORK_US - 1)
+        / OTHER_WORK_US, otherWorkDone);
+}
+
+TEST(AnLCDIntf_11Wires_Yield, StopsYieldingOnceHookIsRemoved) {
+    LCDIntf_SetYieldHook(&intf, NULL);
+    LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_PREDICT);
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_LONG_US);
+    ExpectSequence_WriteData('a');
+
+    LCDIntf_WriteInstruction(&intf, DISPLAY_CLEAR);
+    LCDIntf_WriteData(&intf, 'a');
+
+    LONGS_EQUAL(0, otherWorkDone);
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDIntf_10Wires_WriteOnly, LCDIntf_11Wires)
+{
+    void setup() override {
+        MockPeriphIO_Create(40);
+        LCDPortSpy_ResetToDefaultState();
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+        fakeMicroseconds = 1000;
         Expect_ClearRS();
         Expect_ClearRW();
-        Expect_SetCE();
-        Expect_PutData8(cmd);
         Expect_SetDirection_Out8();
-        Expect_ClearCE();
-        Expect_SetDirection_In8();
-        Expect_SetRW();
+        LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_WRITE_ONLY);
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
     }
 
-    void ExpectSequence_8BitReadInstruction(int32_t retVal) {
+    void ExpectSequence_WriteInstruction(int32_t instr) {
         Expect_ClearRS();
-        Expect_SetRW();
         Expect_SetCE();
-        Expect_GetData8ThenReturn(retVal);
+        Expect_PutData8(instr);
         Expect_ClearCE();
     }
 
+    void ExpectSequence_WriteData(int32_t data) {
+        Expect_SetRS();
+        Expect_SetCE();
+        Expect_PutData8(data);
+        Expect_ClearCE();
+    }
+};
+
+TEST(AnLCDIntf_10Wires_WriteOnly, NeverTurnsDataLinesAround) {
+    ExpectSequence_WriteInstruction(0x5A);
+    ExpectSequence_WriteData(0xA5);
+
+    LCDIntf_WriteInstruction(&intf, 0x5A);
+    fakeMicroseconds += LCD_EXECUTION_TIME_SHORT_US;
+    LCDIntf_WriteData(&intf, 0xA5);
+}
+
+TEST(AnLCDIntf_10Wires_WriteOnly, WaitsOutExecutionTimeWithoutPolling) {
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_LONG_US - 20);
+    ExpectSequence_WriteData('a');
+
+    LCDIntf_WriteInstruction(&intf, DISPLAY_CLEAR);
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+    fakeMicroseconds += 20;
+    LCDIntf_WriteData(&intf, 'a');
+}
+
+TEST(AnLCDIntf_10Wires_WriteOnly, CannotProbeController) {
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, LCDIntf_ProbeLCDController(&intf));
+}
+
+TEST(AnLCDIntf_10Wires_WriteOnly, RefusesToRead) {
+    LONGS_EQUAL(-1, LCDIntf_ReadData(&intf));
+    LONGS_EQUAL(-1, LCDIntf_ReadInstruction(&intf));
+}
+
+TEST(AnLCDIntf_10Wires_WriteOnly, InitializesControllerUsingTimingTable) {
+    ExpectSequence_WriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+    ExpectCall_Delay_microseconds(39);
+    ExpectSequence_WriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+    ExpectCall_Delay_microseconds(37);
+    ExpectSequence_WriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_LONG_US);
+    ExpectSequence_WriteInstruction(ENTRY_MODE_SET__I_D_SH);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController(&intf));
+}
+
+TEST(AnLCDIntf_10Wires_WriteOnly, SelectsRegisterOncePerBurst) {
+    const uint8_t burst[] = { 'a', 'b', 'c' };
+
+    Expect_SetRS();
+    Expect_SetCE();
+    Expect_PutData8('a');
+    Expect_ClearCE();
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    Expect_SetCE();
+    Expect_PutData8('b');
+    Expect_ClearCE();
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    Expect_SetCE();
+    Expect_PutData8('c');
+    Expect_ClearCE();
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WriteDataBurst(&intf, burst, 3));
+}
+
+TEST(AnLCDIntf_10Wires_WriteOnly, TimesInstructionBurstPerInstruction) {
+    const uint8_t burst[] = { DISPLAY_CLEAR, ENTRY_MODE_SET__I_D_SH, 0x80 };
+
+    Expect_ClearRS();
+    Expect_SetCE();
+    Expect_PutData8(DISPLAY_CLEAR);
+    Expect_ClearCE();
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_LONG_US);
+    Expect_SetCE();
+    Expect_PutData8(ENTRY_MODE_SET__I_D_SH);
+    Expect_ClearCE();
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    Expect_SetCE();
+    Expect_PutData8(0x80);
+    Expect_ClearCE();
+
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDIntf_WriteInstructionBurst(&intf, burst, 3));
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDIntf_11Wires_Async, LCDIntf_11Wires)
+{
+    void setup() override {
+        MockPeriphIO_Create(40);
+        LCDPortSpy_ResetToDefaultState();
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
+    }
+};
+
+TEST(AnLCDIntf_11Wires_Async, QueueingDoesNotTouchTheBus) {
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDIntf_QueueInstruction(&intf, DISPLAY_CLEAR));
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_QueueData(&intf, 'a'));
+}
+
+TEST(AnLCDIntf_11Wires_Async, IdlePollDoesNothing) {
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Poll(&intf));
+}
+
+TEST(AnLCDIntf_11Wires_Async, PollDoesOneStepAtATime) {
+    ExpectSequence_WriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__BUSY_FLAG);
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+    ExpectSequence_WriteData('a');
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+
+    LCDIntf_QueueInstruction(&intf, DISPLAY_CLEAR);
+    LCDIntf_QueueData(&intf, 'a');
+
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Poll(&intf));
+}
+
+TEST(AnLCDIntf_11Wires_Async, ReportsControllerTimeout) {
+    fakeClockTick = 1;
+    ExpectSequence_WriteData('a');
+    for (int i = 0; i < LCD_BUSY_TIMEOUT_SHORT_US; ++i)
+        ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__BUSY_FLAG);
+
+    LCDIntf_QueueData(&intf, 'a');
+
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    for (int i = 1; i < LCD_BUSY_TIMEOUT_SHORT_US; ++i)
+        LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Poll(&intf));
+}
+
+TEST(AnLCDIntf_11Wires_Async, BlockingWriteDrainsTheQueueFirst) {
+    ExpectSequence_WriteData('a');
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+    ExpectSequence_WriteData('b');
+
+    LCDIntf_QueueData(&intf, 'a');
+    LCDIntf_WriteData(&intf, 'b');
+}
+
+TEST(AnLCDIntf_11Wires_Async, RejectsOperationsWhenQueueIsFull) {
+    for (int i = 0; i < LCD_INTF_QUEUE_SIZE; ++i)
+        LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_QueueData(&intf, 'x'));
+
+    LONGS_EQUAL(LCD_OPERATION_QUEUE_FULL, LCDIntf_QueueData(&intf, 'y'));
+}
+
+TEST(AnLCDIntf_11Wires_Async, CountsRejectedOperations) {
+    for (int i = 0; i < LCD_INTF_QUEUE_SIZE; ++i)
+        LCDIntf_QueueData(&intf, 'x');
+    LCDIntf_QueueData(&intf, 'y');
+    LCDIntf_QueueData(&intf, 'z');
+
+    LONGS_EQUAL(2, LCDIntf_GetQueueOverflows(&intf));
+}
+
+TEST(AnLCDIntf_11Wires_Async, RemembersQueueHighWatermark) {
+    ExpectSequence_WriteData('a');
+
+    LCDIntf_QueueData(&intf, 'a');
+    LCDIntf_QueueData(&intf, 'b');
+    LCDIntf_QueueData(&intf, 'c');
+    LCDIntf_Poll(&intf);
+
+    LONGS_EQUAL(3, LCDIntf_GetQueueHighWatermark(&intf));
+}
+
+TEST(AnLCDIntf_11Wires_Async, DeinitResetsQueueStatistics) {
+    for (int i = 0; i <= LCD_INTF_QUEUE_SIZE; ++i)
+        LCDIntf_QueueData(&intf, 'x');
+
+    LCDIntf_Deinit(&intf);
+
+    LONGS_EQUAL(0, LCDIntf_GetQueueOverflows(&intf));
+    LONGS_EQUAL(0, LCDIntf_GetQueueHighWatermark(&intf));
+}
+
+TEST(AnLCDIntf_11Wires_Async, PredictedReadinessCostsNoBusCycles) {
+    fakeMicroseconds = 0;
+    LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_PREDICT);
+    ExpectSequence_WriteData('a');
+
+    LCDIntf_QueueData(&intf, 'a');
+
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    fakeMicroseconds += LCD_EXECUTION_TIME_SHORT_US;
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Poll(&intf));
+}
+
+/* ====================================================================== */
+struct LCDControllerInit_11Wires : public LCDIntf_11Wires
+{
+    void ExpectSequence_8BitWriteInstruction(int32_t cmd) {
+        ExpectSequence_WriteInstruction(cmd);
+    }
+
     void ExpectSequence_8BitRead_NoBusyFlag() {
-        ExpectSequence_8BitReadInstruction(READ_INSTRUCTION__NO_BUSY_FLAG);
+        ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__NO_BUSY_FLAG);
+    }
+
+    void ExpectSequence_8BitRead_BusyFlag() {
+        ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__BUSY_FLAG);
     }
 
     // XXX consider better name
-    void ExpectSequence_8BitRead_BusyFlag_ReadTimeout() {
-        Expect_ClearRS();
-        Expect_SetRW();
-        Expect_SetCE();
-        for (int i = 0; i < BUSY_FLAG_READS_BEFORE_GIVING_UP; ++i) 
-            Expect_GetData8ThenReturn(READ_INSTRUCTION__BUSY_FLAG);
-        Expect_ClearCE();
+    void ExpectSequence_8BitRead_BusyFlag_ReadTimeout(
+            uint32_t budget = LCD_BUSY_TIMEOUT_SHORT_US) {
+        ExpectSequence_ReadBusyFlagUntilTimeout(budget);
     }
 };
 
@@ -288,11 +856,12 @@ TEST_GROUP_BASE(AnLCDControllerInit_11Wires, LCDControllerInit_11Wires)
     void setup() override {
         MockPeriphIO_Create(70);
         LCDPortSpy_ResetToDefaultState();
-        LCDIntf_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
     }
 
     void teardown() override {
-        LCDIntf_Deinit();
+        LCDIntf_Deinit(&intf);
         MockPeriphIO_Verify_Complete();
         MockPeriphIO_Destroy();
     }
@@ -315,7 +884,7 @@ TEST(AnLCDControllerInit_11Wires, PreparesDisplayFor8BitInterfacing) {
     ExpectSequence_8BitRead_NoBusyFlag();
 
  
-    LCDIntf_InitializeLCDController();
+    LCDIntf_InitializeLCDController(&intf);
 }
 
 TEST(AnLCDControllerInit_11Wires, ReportsSuccessInSetupOf8BitMode) {
@@ -335,7 +904,7 @@ TEST(AnLCDControllerInit_11Wires, ReportsSuccessInSetupOf8BitMode) {
     ExpectSequence_8BitRead_NoBusyFlag();
 
  
-    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController(&intf));
 }
 
 TEST(AnLCDControllerInit_11Wires, DetectsReadTimeoutOnDisplayControlInstruction)
@@ -350,7 +919,7 @@ TEST(AnLCDControllerInit_11Wires, DetectsReadTimeoutOnDisplayControlInstruction)
     ExpectSequence_8BitRead_BusyFlag_ReadTimeout();
 
 
-    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController(&intf));
 }
 
 TEST(AnLCDControllerInit_11Wires, DetectsReadTimeoutOnDisplayClearInstruction)
@@ -365,10 +934,10 @@ TEST(AnLCDControllerInit_11Wires, DetectsReadTimeoutOnDisplayClearInstruction)
     ExpectSequence_8BitRead_NoBusyFlag();
 
     ExpectSequence_8BitWriteInstruction(DISPLAY_CLEAR);
-    ExpectSequence_8BitRead_BusyFlag_ReadTimeout();
+    ExpectSequence_8BitRead_BusyFlag_ReadTimeout(LCD_BUSY_TIMEOUT_LONG_US);
 
 
-    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController(&intf));
 }
 
 TEST(AnLCDControllerInit_11Wires, DetectsReadTimeoutOnEntryModeSetInstruction)
@@ -389,11 +958,312 @@ TEST(AnLCDControllerInit_11Wires, DetectsReadTimeoutOnEntryModeSetInstruction)
     ExpectSequence_8BitRead_BusyFlag_ReadTimeout();
 
 
-    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController(&intf));
+}
+
+TEST(AnLCDControllerInit_11Wires, RunsSuppliedInitSequence) {
+    const LCDInitStep oneLine5x8[] = {
+        { FUNCTION_SET, LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_SETUP, 0 },
+        { DISPLAY_CLEAR, LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_LONG, 1 },
+    };
+    ExpectSequence_8BitWriteInstruction(FUNCTION_SET | FUNCTION_SET__8BIT);
+    ExpectCall_Delay_microseconds(LCD_INIT_SETUP_DELAY_US);
+    ExpectSequence_8BitWriteInstruction(DISPLAY_CLEAR);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_LONG_US);
+    ExpectSequence_8BitRead_NoBusyFlag();
+
+    LCDIntf_SetInitSequence(&intf, oneLine5x8, 2);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController(&intf));
+}
+
+TEST(AnLCDControllerInit_11Wires, SkipsNibbleStepsOn8BitBus) {
+    const LCDInitStep steps[] = {
+        { FUNCTION_SET__8BIT, LCD_INIT_STEP_4BIT_NIBBLE,
+            LCD_INIT_DELAY_SETUP, 0 },
+        { DISPLAY_CLEAR, LCD_INIT_STEP_INSTRUCTION, LCD_INIT_DELAY_NONE, 0 },
+    };
+    ExpectSequence_8BitWriteInstruction(DISPLAY_CLEAR);
+
+    LCDIntf_SetInitSequence(&intf, steps, 2);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController(&intf));
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDControllerInit_11Wires_Async, LCDControllerInit_11Wires)
+{
+    void setup() override {
+        MockPeriphIO_Create(100);
+        LCDPortSpy_ResetToDefaultState();
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+        fakeMicroseconds = 0;
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
+    }
+
+    void PollAt(uint32_t microseconds, int32_t expectedStatus) {
+        fakeMicroseconds = microseconds;
+        LONGS_EQUAL(expectedStatus, LCDIntf_Poll(&intf));
+    }
+
+    void ExpectSequence_InitUpToDisplayControl() {
+        ExpectSequence_8BitWriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+        ExpectSequence_8BitWriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+        ExpectSequence_8BitWriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
+    }
+
+    void RunInitUpToDisplayControl() {
+        PollAt(LCD_POWER_ON_DELAY_US, LCD_OPERATION_PENDING);
+        PollAt(LCD_POWER_ON_DELAY_US + 39, LCD_OPERATION_PENDING);
+        PollAt(LCD_POWER_ON_DELAY_US + 39 + 37, LCD_OPERATION_PENDING);
+    }
+};
+
+TEST(AnLCDControllerInit_11Wires_Async, StartReturnsAtOnce) {
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_StartLCDControllerInit(&intf));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_GetInitStatus(&intf));
+}
+
+TEST(AnLCDControllerInit_11Wires_Async, WaitsOutPowerOnDelay) {
+    LCDIntf_StartLCDControllerInit(&intf);
+
+    PollAt(LCD_POWER_ON_DELAY_US - 1, LCD_OPERATION_PENDING);
+}
+
+TEST(AnLCDControllerInit_11Wires_Async, SendsEachStepWhenItsDeadlinePasses) {
+    ExpectSequence_8BitWriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+    ExpectSequence_8BitWriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+
+    LCDIntf_StartLCDControllerInit(&intf);
+
+    PollAt(LCD_POWER_ON_DELAY_US, LCD_OPERATION_PENDING);
+    PollAt(LCD_POWER_ON_DELAY_US + 38, LCD_OPERATION_PENDING);
+    PollAt(LCD_POWER_ON_DELAY_US + 39, LCD_OPERATION_PENDING);
+    PollAt(LCD_POWER_ON_DELAY_US + 39 + 36, LCD_OPERATION_PENDING);
+}
+
+TEST(AnLCDControllerInit_11Wires_Async, ChecksBusyFlagOncePerPoll) {
+    ExpectSequence_InitUpToDisplayControl();
+    ExpectSequence_8BitRead_BusyFlag();
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_8BitWriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_8BitWriteInstruction(ENTRY_MODE_SET__I_D_SH);
+    ExpectSequence_8BitRead_NoBusyFlag();
+
+    LCDIntf_StartLCDControllerInit(&intf);
+    RunInitUpToDisplayControl();
+
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_GetInitStatus(&intf));
+}
+
+TEST(AnLCDControllerInit_11Wires_Async, QueuesWritesIssuedDuringInit) {
+    const uint8_t burst[] = { 'b', 'c' };
+    ExpectSequence_InitUpToDisplayControl();
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_8BitWriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_8BitWriteInstruction(ENTRY_MODE_SET__I_D_SH);
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_WriteData('a');
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_WriteData('b');
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_WriteData('c');
+    ExpectSequence_8BitRead_NoBusyFlag();
+
+    LCDIntf_StartLCDControllerInit(&intf);
+    LCDIntf_WriteData(&intf, 'a');
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WriteDataBurst(&intf, burst, 2));
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_WaitWhileBusy(&intf));
+    RunInitUpToDisplayControl();
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Drain(&intf));
+}
+
+TEST(AnLCDControllerInit_11Wires_Async, WaitsOutExecutionTimesWithoutRWLine)
+{
+    const uint32_t displayControlAt = LCD_POWER_ON_DELAY_US + 39 + 37;
+    const uint32_t clearAt = displayControlAt + LCD_EXECUTION_TIME_SHORT_US;
+    const uint32_t entryModeAt = clearAt + LCD_EXECUTION_TIME_LONG_US;
+    Expect_ClearRS();
+    Expect_ClearRW();
+    Expect_SetDirection_Out8();
+    dataLinesDriven = true;
+    ExpectSequence_InitUpToDisplayControl();
+    ExpectSequence_8BitWriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_8BitWriteInstruction(ENTRY_MODE_SET__I_D_SH);
+
+    LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_WRITE_ONLY);
+    LCDIntf_StartLCDControllerInit(&intf);
+    RunInitUpToDisplayControl();
+
+    PollAt(clearAt - 1, LCD_OPERATION_PENDING);
+    PollAt(clearAt, LCD_OPERATION_PENDING);
+    PollAt(entryModeAt - 1, LCD_OPERATION_PENDING);
+    PollAt(entryModeAt, LCD_OPERATION_PENDING);
+    PollAt(entryModeAt + LCD_EXECUTION_TIME_SHORT_US, LCD_OPERATION_OK);
+}
+
+TEST(AnLCDControllerInit_11Wires_Async, ReportsTimeoutOfInit) {
+    ExpectSequence_InitUpToDisplayControl();
+    for (int i = 0; i <= LCD_BUSY_TIMEOUT_SHORT_US; ++i)
+        ExpectSequence_8BitRead_BusyFlag();
+
+    LCDIntf_StartLCDControllerInit(&intf);
+    RunInitUpToDisplayControl();
+    fakeClockTick = 1;
+    for (int i = 0; i < LCD_BUSY_TIMEOUT_SHORT_US; ++i)
+        LONGS_EQUAL(LCD_OPERATION_PENDING, LCDIntf_Poll(&intf));
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_Poll(&intf));
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_GetInitStatus(&intf));
 }
 
 /* ====================================================================== */
-struct LCDIntf_7Wires : public LCDIntf
+TEST_GROUP_BASE(AnLCDControllerProbe_11Wires, LCDControllerInit_11Wires)
+{
+    void setup() override {
+        MockPeriphIO_Create(200);
+        LCDPortSpy_ResetToDefaultState();
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
+    }
+
+    static int32_t SignatureRow(int row) {
+        return (LCD_SIGNATURE + row * LCD_SIGNATURE_STEP) & 0x1F;
+    }
+
+    // rows up to the first one that differs from the signature are read
+    void ExpectSequence_ReadSignatureThenReturn(const int32_t * rows) {
+        ExpectSequence_8BitWriteInstruction(
+            SET_CGRAM_ADDRESS_CMD | LCD_SIGNATURE_CGRAM_ADDR);
+        ExpectSequence_8BitRead_NoBusyFlag();
+        for (int row = 0; row < LCD_SIGNATURE_ROWS; ++row) {
+            ExpectSequence_ReadData(rows[row]);
+            ExpectSequence_8BitRead_NoBusyFlag();
+            if ((rows[row] & 0x1F) != SignatureRow(row))
+                break;
+        }
+    }
+
+    void ExpectSequence_ReadSignature(int32_t unusedBits = 0) {
+        int32_t rows[LCD_SIGNATURE_ROWS];
+        for (int row = 0; row < LCD_SIGNATURE_ROWS; ++row)
+            rows[row] = unusedBits | SignatureRow(row);
+        ExpectSequence_ReadSignatureThenReturn(rows);
+    }
+
+    void ExpectSequence_SetDDRAMAddress(int32_t addr) {
+        ExpectSequence_8BitWriteInstruction(SET_DDRAM_ADDRESS_CMD | addr);
+        ExpectSequence_8BitRead_NoBusyFlag();
+    }
+};
+
+TEST(AnLCDControllerProbe_11Wires, FindsConfiguredController) {
+    ExpectSequence_ReadBusyFlag(0x45);
+    ExpectSequence_ReadSignature();
+    ExpectSequence_SetDDRAMAddress(0x45);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_ProbeLCDController(&intf));
+}
+
+TEST(AnLCDControllerProbe_11Wires, IgnoresUnusedBitsOfSignature) {
+    ExpectSequence_ReadBusyFlag(0x00);
+    ExpectSequence_ReadSignature(0xE0);
+    ExpectSequence_SetDDRAMAddress(0x00);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_ProbeLCDController(&intf));
+}
+
+TEST(AnLCDControllerProbe_11Wires, RejectsBusyController) {
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__BUSY_FLAG);
+
+    LONGS_EQUAL(LCD_OPERATION_NOT_CONFIGURED,
+        LCDIntf_ProbeLCDController(&intf));
+}
+
+TEST(AnLCDControllerProbe_11Wires, RejectsControllerWithoutSignature) {
+    int32_t rows[LCD_SIGNATURE_ROWS] = { ~SignatureRow(0) & 0x1F };
+    ExpectSequence_ReadBusyFlag(0x00);
+    ExpectSequence_ReadSignatureThenReturn(rows);
+    ExpectSequence_SetDDRAMAddress(0x00);
+
+    LONGS_EQUAL(LCD_OPERATION_NOT_CONFIGURED,
+        LCDIntf_ProbeLCDController(&intf));
+}
+
+TEST(AnLCDControllerProbe_11Wires, RejectsSignatureWithALastRowAmiss) {
+    int32_t rows[LCD_SIGNATURE_ROWS];
+    for (int row = 0; row < LCD_SIGNATURE_ROWS; ++row)
+        rows[row] = SignatureRow(row);
+    rows[LCD_SIGNATURE_ROWS - 1] ^= 0x01;
+    ExpectSequence_ReadBusyFlag(0x00);
+    ExpectSequence_ReadSignatureThenReturn(rows);
+    ExpectSequence_SetDDRAMAddress(0x00);
+
+    LONGS_EQUAL(LCD_OPERATION_NOT_CONFIGURED,
+        LCDIntf_ProbeLCDController(&intf));
+}
+
+TEST(AnLCDControllerProbe_11Wires, ResumesConfiguredController) {
+    ExpectSequence_ReadBusyFlag(0x10);
+    ExpectSequence_ReadSignature();
+    ExpectSequence_SetDDRAMAddress(0x10);
+
+    LONGS_EQUAL(LCD_OPERATION_RESUMED,
+        LCDIntf_ResumeOrInitializeLCDController(&intf));
+}
+
+TEST(AnLCDControllerProbe_11Wires, InitializesAndSignsUnconfiguredController) {
+    ExpectSequence_ReadBusyFlag(READ_INSTRUCTION__BUSY_FLAG);
+    ExpectSequence_8BitWriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+    ExpectCall_Delay_microseconds(LCD_INIT_SETUP_DELAY_US);
+    ExpectSequence_8BitWriteInstruction(FUNCTION_SET__8BIT_2LINE_8x11FONT);
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    ExpectSequence_8BitWriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_8BitWriteInstruction(DISPLAY_CLEAR);
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_8BitWriteInstruction(ENTRY_MODE_SET__I_D_SH);
+    ExpectSequence_8BitRead_NoBusyFlag();
+    ExpectSequence_8BitWriteInstruction(
+        SET_CGRAM_ADDRESS_CMD | LCD_SIGNATURE_CGRAM_ADDR);
+    ExpectSequence_8BitRead_NoBusyFlag();
+    for (int row = 0; row < LCD_SIGNATURE_ROWS; ++row) {
+        Expect_SetRS();
+        Expect_ClearRW();
+        Expect_SetDirection_Out8();
+        Expect_SetCE();
+        Expect_PutData8(SignatureRow(row));
+        Expect_ClearCE();
+        dataLinesDriven = true;
+        ExpectSequence_8BitRead_NoBusyFlag();
+    }
+    ExpectSequence_SetDDRAMAddress(0x00);
+
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDIntf_ResumeOrInitializeLCDController(&intf));
+}
+
+/* ====================================================================== */
+struct LCDIntf_7Wires : public LCDIntfTest
 {
     void Expect_PutData4(int32_t data) {
         MockPeriphIO_Expect_Write(LCD_DATA4_ADDR, data);
@@ -417,13 +1287,14 @@ struct LCDIntf_7Wires : public LCDIntf
 TEST_GROUP_BASE(AnLCDIntf_7Wires, LCDIntf_7Wires)
 {
     void setup() override {
-        MockPeriphIO_Create(15);
+        MockPeriphIO_Create(20);
         LCDPortSpy_ResetToDefaultState();
-        LCDIntf_Init(LCD_PORT_DATA_WIDTH_4_BIT);
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_4_BIT);
     }
 
     void teardown() override {
-        LCDIntf_Deinit();
+        LCDIntf_Deinit(&intf);
         MockPeriphIO_Verify_Complete();
         MockPeriphIO_Destroy();
     }
@@ -440,10 +1311,8 @@ TEST(AnLCDIntf_7Wires, WritesInstruction) {
     Expect_SetCE();
     Expect_PutData4( LO_NIB(cmd) );
     Expect_ClearCE();
-    Expect_SetDirection_In4();
-    Expect_SetRW();
 
-    LCDIntf_WriteInstruction(0x7B);
+    LCDIntf_WriteInstruction(&intf, 0x7B);
 }
 
 TEST(AnLCDIntf_7Wires, WritesData) {
@@ -457,10 +1326,58 @@ TEST(AnLCDIntf_7Wires, WritesData) {
     Expect_SetCE();
     Expect_PutData4( LO_NIB(data) );
     Expect_ClearCE();
+
+    LCDIntf_WriteData(&intf, data);
+}
+
+TEST(AnLCDIntf_7Wires, TurnsDataLinesAroundOnlyToRead) {
+    int32_t data = 0x23;
+    Expect_SetRS();
+    Expect_ClearRW();
+    Expect_SetCE();
+    Expect_PutData4( HI_NIB(data) );
+    Expect_SetDirection_Out4();
+    Expect_ClearCE();
+    Expect_SetCE();
+    Expect_PutData4( LO_NIB(data) );
+    Expect_ClearCE();
     Expect_SetDirection_In4();
+    Expect_SetRS();
     Expect_SetRW();
+    Expect_SetCE();
+    Expect_GetData4ThenReturn( HI_NIB(data) );
+    Expect_ClearCE();
+    Expect_SetCE();
+    Expect_GetData4ThenReturn( LO_NIB(data) );
+    Expect_ClearCE();
 
-    LCDIntf_WriteData(data);
+    LCDIntf_WriteData(&intf, data);
+    LONGS_EQUAL(data, LCDIntf_ReadData(&intf));
+}
+
+TEST(AnLCDIntf_7Wires, ClocksBurstOutInNibbles) {
+    const uint8_t burst[] = { 0x23, 0x45 };
+
+    Expect_ClearRS();
+    Expect_ClearRW();
+    Expect_SetDirection_Out4();
+    Expect_SetRS();
+    Expect_SetCE();
+    Expect_PutData4( HI_NIB(0x23) );
+    Expect_ClearCE();
+    Expect_SetCE();
+    Expect_PutData4( LO_NIB(0x23) );
+    Expect_ClearCE();
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+    Expect_SetCE();
+    Expect_PutData4( HI_NIB(0x45) );
+    Expect_ClearCE();
+    Expect_SetCE();
+    Expect_PutData4( LO_NIB(0x45) );
+    Expect_ClearCE();
+
+    LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_WRITE_ONLY);
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WriteDataBurst(&intf, burst, 2));
 }
 
 TEST(AnLCDIntf_7Wires, ReadsData) {
@@ -474,7 +1391,7 @@ TEST(AnLCDIntf_7Wires, ReadsData) {
     Expect_GetData4ThenReturn( LO_NIB(data) );
     Expect_ClearCE();
 
-    LONGS_EQUAL(data, LCDIntf_ReadData());
+    LONGS_EQUAL(data, LCDIntf_ReadData(&intf));
 }
 
 TEST(AnLCDIntf_7Wires, ReadsBusyFlagAndAddress) {
@@ -488,7 +1405,7 @@ TEST(AnLCDIntf_7Wires, ReadsBusyFlagAndAddress) {
     Expect_GetData4ThenReturn( LO_NIB(busyFlagAndAddr) );
     Expect_ClearCE();
 
-    LONGS_EQUAL(busyFlagAndAddr, LCDIntf_ReadInstruction());
+    LONGS_EQUAL(busyFlagAndAddr, LCDIntf_ReadInstruction(&intf));
 }
 
 TEST(AnLCDIntf_7Wires, WaitForBusyFlag_ReadyImmediately) {
@@ -501,7 +1418,7 @@ TEST(AnLCDIntf_7Wires, WaitForBusyFlag_ReadyImmediately) {
     Expect_GetData4ThenReturn( LO_NIB(READ_INSTRUCTION__NO_BUSY_FLAG) );
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_OK, status);
 }
@@ -518,7 +1435,7 @@ TEST(AnLCDIntf_7Wires, WaitForBusyFlag_NotImmediatelyReady) {
     Expect_GetData4ThenReturn( LO_NIB(READ_INSTRUCTION__NO_BUSY_FLAG) );
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_OK, status);
 }
@@ -538,27 +1455,45 @@ TEST(AnLCDIntf_7Wires, WaitForBusyFlag_ActsUponBusyFlagOnly) {
     Expect_GetData4ThenReturn( LO_NIB(noBusyFlagButAddr) );
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_OK, status);
 }
 
 TEST(AnLCDIntf_7Wires, WaitForBusyFlag_ReadTimeout) {
+    fakeClockTick = 1;
     Expect_ClearRS();
     Expect_SetRW();
     Expect_SetCE();
-    for (int i = 0; i < BUSY_FLAG_READS_BEFORE_GIVING_UP; ++i) 
+    for (int i = 0; i < LCD_BUSY_TIMEOUT_SHORT_US; ++i)
         Expect_GetData4ThenReturn( HI_NIB(READ_INSTRUCTION__BUSY_FLAG) );
     Expect_ClearCE();
     Expect_SetCE();
     Expect_GetData4ThenReturn( LO_NIB(READ_INSTRUCTION__BUSY_FLAG) );
     Expect_ClearCE();
 
-    int status = LCDIntf_WaitWhileBusy();
+    int status = LCDIntf_WaitWhileBusy(&intf);
 
     LONGS_EQUAL(LCD_OPERATION_TIMEOUT, status);
 }
 
+TEST(AnLCDIntf_7Wires, WritesDataWithRWTiedLow) {
+    int32_t data = 0x23;
+    Expect_ClearRS();
+    Expect_ClearRW();
+    Expect_SetDirection_Out4();
+    Expect_SetRS();
+    Expect_SetCE();
+    Expect_PutData4( HI_NIB(data) );
+    Expect_ClearCE();
+    Expect_SetCE();
+    Expect_PutData4( LO_NIB(data) );
+    Expect_ClearCE();
+
+    LCDIntf_SetBusyMode(&intf, LCD_BUSY_MODE_WRITE_ONLY);
+    LCDIntf_WriteData(&intf, data);
+}
+
 /* ====================================================================== */
 struct LCDControllerInit_7Wires : public LCDIntf_7Wires
 {
@@ -576,19 +1511,26 @@ struct LCDControllerInit_7Wires : public LCDIntf_7Wires
         Expect_ClearCE();
     }
 
-    void ExpectSequence_PutNibbleAndSetInputDirection(int32_t n) {
-        Expect_SetCE();
-        Expect_PutData4(n);
-        Expect_ClearCE();
-        Expect_SetDirection_In4();
-        Expect_SetRW();
+    void ExpectSequence_WriteInstruction(int32_t instr) {
+        Expect_ClearRS();
+        ExpectSequence_PutNibble(HI_NIB(instr));
+        ExpectSequence_PutNibble(LO_NIB(instr));
     }
 
-    void ExpectSequence_4BitRead_BusyFlag_ReadTimeout() {
+    void ExpectSequence_DriveDataLinesAndWriteInstruction(int32_t instr) {
+        Expect_ClearRS();
+        ExpectSequence_SetOutDirectionAndPutNibble(HI_NIB(instr));
+        ExpectSequence_PutNibble(LO_NIB(instr));
+    }
+
+    void ExpectSequence_4BitRead_BusyFlag_ReadTimeout(
+            uint32_t budget = LCD_BUSY_TIMEOUT_SHORT_US) {
+        fakeClockTick = 1;
+        Expect_SetDirection_In4();
         Expect_ClearRS();
         Expect_SetRW();
         Expect_SetCE();
-        for (int i = 0; i < BUSY_FLAG_READS_BEFORE_GIVING_UP; ++i) 
+        for (uint32_t i = 0; i < budget; ++i)
             Expect_GetData4ThenReturn( HI_NIB(READ_INSTRUCTION__BUSY_FLAG) );
         Expect_ClearCE();
         Expect_SetCE();
@@ -597,6 +1539,7 @@ struct LCDControllerInit_7Wires : public LCDIntf_7Wires
     }
 
     void ExpectSequence_4BitRead_NoBusyFlag() {
+        Expect_SetDirection_In4();
         Expect_ClearRS();
         Expect_SetRW();
         Expect_SetCE();
@@ -613,11 +1556,12 @@ TEST_GROUP_BASE(AnLCDControllerInit_7Wires, LCDControllerInit_7Wires)
     void setup() override {
         MockPeriphIO_Create(80);
         LCDPortSpy_ResetToDefaultState();
-        LCDIntf_Init(LCD_PORT_DATA_WIDTH_4_BIT);
+        fakeClockTick = 0;
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_4_BIT);
     }
 
     void teardown() override {
-        LCDIntf_Deinit();
+        LCDIntf_Deinit(&intf);
         MockPeriphIO_Verify_Complete();
         MockPeriphIO_Destroy();
     }
@@ -631,35 +1575,27 @@ TEST(AnLCDControllerInit_7Wires, PreparesDisplayFor4BitInterfacing) {
     ExpectCall_Delay_microseconds(39);
 
     // step #2: now turn '4bit' interfacing
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(39);
 
     // step #3: turn '4bit' again -- the datasheet insists
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(37);
 
     // step #4: Display On/Off Control
-    ExpectSequence_PutNibble(HI_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-                             LO_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
+    ExpectSequence_WriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
     ExpectSequence_4BitRead_NoBusyFlag();
 
     // step #5: Display Clear
-    ExpectSequence_SetOutDirectionAndPutNibble(  HI_NIB(DISPLAY_CLEAR));
-    ExpectSequence_PutNibbleAndSetInputDirection(LO_NIB(DISPLAY_CLEAR));
+    ExpectSequence_DriveDataLinesAndWriteInstruction(DISPLAY_CLEAR);
     ExpectSequence_4BitRead_NoBusyFlag();
 
     // step #6: Entry Mode Set
-    ExpectSequence_SetOutDirectionAndPutNibble(
-        HI_NIB(ENTRY_MODE_SET__I_D_SH));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-        LO_NIB(ENTRY_MODE_SET__I_D_SH));
+    ExpectSequence_DriveDataLinesAndWriteInstruction(ENTRY_MODE_SET__I_D_SH);
     ExpectSequence_4BitRead_NoBusyFlag();
 
 
-    LCDIntf_InitializeLCDController();
+    LCDIntf_InitializeLCDController(&intf);
 }
 
 TEST(AnLCDControllerInit_7Wires, ReportsSuccessInSetupOf4BitMode) {
@@ -668,31 +1604,23 @@ TEST(AnLCDControllerInit_7Wires, ReportsSuccessInSetupOf4BitMode) {
         HI_NIB(FUNCTION_SET__8BIT_2LINE_8x11FONT));
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(37);
 
-    ExpectSequence_PutNibble(HI_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-                             LO_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
+    ExpectSequence_WriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
     ExpectSequence_4BitRead_NoBusyFlag();
 
-    ExpectSequence_SetOutDirectionAndPutNibble(  HI_NIB(DISPLAY_CLEAR));
-    ExpectSequence_PutNibbleAndSetInputDirection(LO_NIB(DISPLAY_CLEAR));
+    ExpectSequence_DriveDataLinesAndWriteInstruction(DISPLAY_CLEAR);
     ExpectSequence_4BitRead_NoBusyFlag();
 
-    ExpectSequence_SetOutDirectionAndPutNibble(
-        HI_NIB(ENTRY_MODE_SET__I_D_SH));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-        LO_NIB(ENTRY_MODE_SET__I_D_SH));
+    ExpectSequence_DriveDataLinesAndWriteInstruction(ENTRY_MODE_SET__I_D_SH);
     ExpectSequence_4BitRead_NoBusyFlag();
 
 
-    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController(&intf));
 }
 
 TEST(AnLCDControllerInit_7Wires, DetectsReadTimeoutOnDisplayControlInstruction)
@@ -702,22 +1630,18 @@ TEST(AnLCDControllerInit_7Wires, DetectsReadTimeoutOnDisplayControlInstruction)
         HI_NIB(FUNCTION_SET__8BIT_2LINE_8x11FONT));
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(37);
 
-    ExpectSequence_PutNibble(HI_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-                             LO_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
+    ExpectSequence_WriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
 
 
     ExpectSequence_4BitRead_BusyFlag_ReadTimeout();
 
-    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController(&intf));
 }
 
 TEST(AnLCDControllerInit_7Wires, DetectsReadTimeoutOnDisplayClearInstruction) {
@@ -726,26 +1650,21 @@ TEST(AnLCDControllerInit_7Wires, DetectsReadTimeoutOnDisplayClearInstruction) {
         HI_NIB(FUNCTION_SET__8BIT_2LINE_8x11FONT));
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(37);
 
-    ExpectSequence_PutNibble(HI_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-                             LO_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
+    ExpectSequence_WriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
     ExpectSequence_4BitRead_NoBusyFlag();
 
-    ExpectSequence_SetOutDirectionAndPutNibble(  HI_NIB(DISPLAY_CLEAR));
-    ExpectSequence_PutNibbleAndSetInputDirection(LO_NIB(DISPLAY_CLEAR));
+    ExpectSequence_DriveDataLinesAndWriteInstruction(DISPLAY_CLEAR);
 
-    ExpectSequence_4BitRead_BusyFlag_ReadTimeout();
+    ExpectSequence_4BitRead_BusyFlag_ReadTimeout(LCD_BUSY_TIMEOUT_LONG_US);
 
 
-    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController(&intf));
 }
 
 TEST(AnLCDControllerInit_7Wires, DetectsReadTimeoutOnEntryModeSetInstruction) {
@@ -754,31 +1673,39 @@ TEST(AnLCDControllerInit_7Wires, DetectsReadTimeoutOnEntryModeSetInstruction) {
         HI_NIB(FUNCTION_SET__8BIT_2LINE_8x11FONT));
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(39);
 
-    ExpectSequence_PutNibble(HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
-    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_WriteInstruction(FUNCTION_SET__4BIT_2LINE_8x11FONT);
     ExpectCall_Delay_microseconds(37);
 
-    ExpectSequence_PutNibble(HI_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-                             LO_NIB(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF));
+    ExpectSequence_WriteInstruction(DISPLAY_CONTROL__D_ON_C_OFF_B_OFF);
     ExpectSequence_4BitRead_NoBusyFlag();
 
-    ExpectSequence_SetOutDirectionAndPutNibble(  HI_NIB(DISPLAY_CLEAR));
-    ExpectSequence_PutNibbleAndSetInputDirection(LO_NIB(DISPLAY_CLEAR));
+    ExpectSequence_DriveDataLinesAndWriteInstruction(DISPLAY_CLEAR);
     ExpectSequence_4BitRead_NoBusyFlag();
 
-    ExpectSequence_SetOutDirectionAndPutNibble(
-        HI_NIB(ENTRY_MODE_SET__I_D_SH));
-    ExpectSequence_PutNibbleAndSetInputDirection(
-        LO_NIB(ENTRY_MODE_SET__I_D_SH));
+    ExpectSequence_DriveDataLinesAndWriteInstruction(ENTRY_MODE_SET__I_D_SH);
 
 
     ExpectSequence_4BitRead_BusyFlag_ReadTimeout();
 
-    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController());
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_InitializeLCDController(&intf));
 }
 
+TEST(AnLCDControllerInit_7Wires, ClearsInterfaceWidthBitOfSuppliedFunctionSet)
+{
+    const LCDInitStep steps[] = {
+        { FUNCTION_SET__8BIT_2LINE_8x11FONT, LCD_INIT_STEP_INSTRUCTION,
+            LCD_INIT_DELAY_SHORT, 0 },
+    };
+    Expect_ClearRS();
+    ExpectSequence_SetOutDirectionAndPutNibble(
+        HI_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectSequence_PutNibble(LO_NIB(FUNCTION_SET__4BIT_2LINE_8x11FONT));
+    ExpectCall_Delay_microseconds(LCD_EXECUTION_TIME_SHORT_US);
+
+    LCDIntf_SetInitSequence(&intf, steps, 1);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController(&intf));
+}
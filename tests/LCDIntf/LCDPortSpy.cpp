@@ -1,3 +1,4 @@
+#include <stddef.h>
 #include <stdint.h>
 extern "C" {
 #include "LCDPort.h"
@@ -21,8 +22,8 @@ LCDPortSpy_ResetToDefaultState()
     lcd_port_data_width = LCD_PORT_DATA_WIDTH_UNDEFINED;
 }
 
-extern "C" void
-LCDPort_Init(int32_t dataWidth)
+static void
+init(void * port, int32_t dataWidth)
 {
     ce_line_state = LINE_STATE_DEASSERTED;
     rs_line_state = LINE_STATE_DEASSERTED;
@@ -31,8 +32,8 @@ LCDPort_Init(int32_t dataWidth)
     lcd_port_data_width = dataWidth;
 }
 
-extern "C" void
-LCDPort_Deinit(void)
+static void
+deinit(void * port)
 {
     LCDPortSpy_ResetToDefaultState();
 }
@@ -44,50 +45,50 @@ setPort_dataDirection(int32_t addr, int32_t d)
     lcd_port_data_direction = d;
 }
 
-extern "C" void
-LCDPort_SetDirection_Input8(void)
+static void
+setDirection_Input8(void * port)
 {
     setPort_dataDirection(LCD_FAKE_DIRECTION8_REG, LCD_PORT_DATA_DIR_INPUT8);
 }
 
-extern "C" void
-LCDPort_SetDirection_Output8(void)
+static void
+setDirection_Output8(void * port)
 {
     setPort_dataDirection(LCD_FAKE_DIRECTION8_REG, LCD_PORT_DATA_DIR_OUTPUT8);
 }
 
-extern "C" void
-LCDPort_SetDirection_Input4(void)
+static void
+setDirection_Input4(void * port)
 {
     setPort_dataDirection(LCD_FAKE_DIRECTION4_REG, LCD_PORT_DATA_DIR_INPUT4);
 }
 
-extern "C" void
-LCDPort_SetDirection_Output4(void)
+static void
+setDirection_Output4(void * port)
 {
     setPort_dataDirection(LCD_FAKE_DIRECTION4_REG, LCD_PORT_DATA_DIR_OUTPUT4);
 }
 
-extern "C" void
-LCDPort_Out8(int32_t n)
+static void
+out8(void * port, int32_t n)
 {
     MockPeriphIO_Write(LCD_DATA8_ADDR, n);
 }
 
-extern "C" void
-LCDPort_Out4(int32_t n)
+static void
+out4(void * port, int32_t n)
 {
     MockPeriphIO_Write(LCD_DATA4_ADDR, n);
 }
 
-extern "C" int32_t
-LCDPort_In8(void)
+static int32_t
+in8(void * port)
 {
     return MockPeriphIO_Read(LCD_DATA8_ADDR);
 }
 
-extern "C" int32_t
-LCDPort_In4(void)
+static int32_t
+in4(void * port)
 {
     return MockPeriphIO_Read(LCD_DATA4_ADDR);
 }
@@ -99,14 +100,14 @@ configureLine_RS(int v)
     rs_line_state = v;
 }
 
-extern "C" void
-LCDPort_SetRS(void)
+static void
+setRS(void * port)
 {
     configureLine_RS(LINE_STATE_ASSERTED);
 }
 
-extern "C" void
-LCDPort_ClearRS(void)
+static void
+clearRS(void * port)
 {
     configureLine_RS(LINE_STATE_DEASSERTED);
 }
@@ -119,14 +120,14 @@ configureLine_RW(int v)
 }
 
 
-extern "C" void
-LCDPort_SetRW(void)
+static void
+setRW(void * port)
 {
     configureLine_RW(LINE_STATE_ASSERTED);
 }
 
-extern "C" void
-LCDPort_ClearRW(void)
+static void
+clearRW(void * port)
 {
     configureLine_RW(LINE_STATE_DEASSERTED);
 }
@@ -138,19 +139,60 @@ configureLine_CE(int v)
     ce_line_state = v;
 }
 
-extern "C" void
-LCDPort_SetCE(void)
+static void
+setCE(void * port)
 {
     configureLine_CE(LINE_STATE_ASSERTED);
-    
 }
 
-extern "C" void
-LCDPort_ClearCE(void)
+static void
+clearCE(void * port)
 {
     configureLine_CE(LINE_STATE_DEASSERTED);
 }
 
+#if defined(LCD_PORT_BUS_CYCLES)
+/*   A whole bus cycle is recorded as one access, the RS line picks the
+ * address.
+ */
+static void
+writeByte(void * port, int32_t rs, int32_t value)
+{
+    MockPeriphIO_Write(LCD_WRITE_CYCLE_ADDR + rs, value);
+    rs_line_state = rs ? LINE_STATE_ASSERTED : LINE_STATE_DEASSERTED;
+    rw_line_state = LINE_STATE_DEASSERTED;
+    ce_line_state = LINE_STATE_DEASSERTED;
+    lcd_port_data_direction = (LCD_PORT_DATA_WIDTH_4_BIT == lcd_port_data_width)
+        ? LCD_PORT_DATA_DIR_OUTPUT4 : LCD_PORT_DATA_DIR_OUTPUT8;
+}
+
+static int32_t
+readByte(void * port, int32_t rs)
+{
+    rs_line_state = rs ? LINE_STATE_ASSERTED : LINE_STATE_DEASSERTED;
+    rw_line_state = LINE_STATE_ASSERTED;
+    ce_line_state = LINE_STATE_DEASSERTED;
+    lcd_port_data_direction = (LCD_PORT_DATA_WIDTH_4_BIT == lcd_port_data_width)
+        ? LCD_PORT_DATA_DIR_INPUT4 : LCD_PORT_DATA_DIR_INPUT8;
+
+    return MockPeriphIO_Read(LCD_READ_CYCLE_ADDR + rs);
+}
+#endif
+
+/*   The spy stands for a single port, the handle is not used. */
+extern "C" const LCDPortOps LCDPortSpy_Ops = {
+    init, deinit,
+    setDirection_Input8, setDirection_Output8,
+    setDirection_Input4, setDirection_Output4,
+    out4, out8, in4, in8,
+    setRS, clearRS, setRW, clearRW, setCE, clearCE,
+#if defined(LCD_PORT_BUS_CYCLES)
+    writeByte, readByte
+#else
+    NULL, NULL
+#endif
+};
+
 int
 LCDPortSpy_GetDataDirection()
 {
@@ -24,8 +24,12 @@ enum {
     LCD_RS_ADDR             = 0x42001000,
     LCD_RW_ADDR,
     LCD_CE_ADDR,
+    LCD_WRITE_CYCLE_ADDR    = 0x44001000,   // + RS
+    LCD_READ_CYCLE_ADDR     = 0x44001010,   // + RS
 };
 
+extern "C" const LCDPortOps LCDPortSpy_Ops;
+
 void LCDPortSpy_ResetToDefaultState();
 int LCDPortSpy_GetDataDirection();
 int LCDPortSpy_GetRS();
@@ -37,15 +37,15 @@ TEST(ALCDPort_InitDeinit, HasUndefinedLineStatesForNoninitializedPort) {
 }
 
 TEST(ALCDPort_InitDeinit, InitializationSetsSpyLinesToKnownState) {
-    LCDPort_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDPortSpy_Ops.init(NULL, LCD_PORT_DATA_WIDTH_8_BIT);
 
     CHECK_PORT_STATE_INITIALIZED_AS(LCD_PORT_DATA_DIR_INPUT8);
 }
 
 TEST(ALCDPort_InitDeinit, DeinitializationResetsSpyToUndefinedState) {
-    LCDPort_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDPortSpy_Ops.init(NULL, LCD_PORT_DATA_WIDTH_8_BIT);
 
-    LCDPort_Deinit();
+    LCDPortSpy_Ops.deinit(NULL);
 
     CHECK_PORT_STATE_UNDEFINED();
 }
@@ -66,60 +66,60 @@ public:
 TEST_GROUP_BASE(AMockedLCDPort, MockedLCDPort)
 {
     void setup() override {
-        LCDPort_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+        LCDPortSpy_Ops.init(NULL, LCD_PORT_DATA_WIDTH_8_BIT);
         MockedLCDPort::setup();
     }
     void teardown() override {
         MockedLCDPort::teardown();
-        LCDPort_Deinit();
+        LCDPortSpy_Ops.deinit(NULL);
     }
 };
 
 TEST(AMockedLCDPort, DetectsRSLineAssertionAndRecordsState) {
     MockPeriphIO_Expect_Write(LCD_RS_ADDR, LINE_STATE_ASSERTED);
 
-    LCDPort_SetRS();
+    LCDPortSpy_Ops.setRS(NULL);
     LONGS_EQUAL(LINE_STATE_ASSERTED, LCDPortSpy_GetRS());
 }
 
 TEST(AMockedLCDPort, DetectsRSLineDeassertionAndReflectsItsFinalState) {
     MockPeriphIO_Expect_Write(LCD_RS_ADDR, LINE_STATE_ASSERTED);
     MockPeriphIO_Expect_Write(LCD_RS_ADDR, LINE_STATE_DEASSERTED);
-    LCDPort_SetRS();
+    LCDPortSpy_Ops.setRS(NULL);
 
-    LCDPort_ClearRS();
+    LCDPortSpy_Ops.clearRS(NULL);
     LONGS_EQUAL(LINE_STATE_DEASSERTED, LCDPortSpy_GetRS());
 }
 
 TEST(AMockedLCDPort, DetectsRWLineDeassertionAndRecordsState) {
     MockPeriphIO_Expect_Write(LCD_RW_ADDR, LINE_STATE_DEASSERTED);
 
-    LCDPort_ClearRW();
+    LCDPortSpy_Ops.clearRW(NULL);
     LONGS_EQUAL(LINE_STATE_DEASSERTED, LCDPortSpy_GetRW());
 }
 
 TEST(AMockedLCDPort, DetectsRWLineAssertionAndRecordsItsFinalState) {
     MockPeriphIO_Expect_Write(LCD_RW_ADDR, LINE_STATE_DEASSERTED);
     MockPeriphIO_Expect_Write(LCD_RW_ADDR, LINE_STATE_ASSERTED);
-    LCDPort_ClearRW();
+    LCDPortSpy_Ops.clearRW(NULL);
 
-    LCDPort_SetRW();
+    LCDPortSpy_Ops.setRW(NULL);
     LONGS_EQUAL(LINE_STATE_ASSERTED, LCDPortSpy_GetRW());
 }
 
 TEST(AMockedLCDPort, DetectsCELineAssertionAndReflectsItsState) {
     MockPeriphIO_Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
 
-    LCDPort_SetCE();
+    LCDPortSpy_Ops.setCE(NULL);
     LONGS_EQUAL(LINE_STATE_ASSERTED, LCDPortSpy_GetCE());
 }
 
 TEST(AMockedLCDPort, DetectsCELineDeassertionAndReflectsItsFinalState) {
     MockPeriphIO_Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
     MockPeriphIO_Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
-    LCDPort_SetCE();
+    LCDPortSpy_Ops.setCE(NULL);
 
-    LCDPort_ClearCE();
+    LCDPortSpy_Ops.clearCE(NULL);
     LONGS_EQUAL(LINE_STATE_DEASSERTED, LCDPortSpy_GetCE());
 }
 
@@ -127,12 +127,12 @@ TEST(AMockedLCDPort, DetectsCELineDeassertionAndReflectsItsFinalState) {
 TEST_GROUP_BASE(AMockedLCDPort8Bit, MockedLCDPort)
 {
     void setup() override {
-        LCDPort_Init(LCD_PORT_DATA_WIDTH_8_BIT);
+        LCDPortSpy_Ops.init(NULL, LCD_PORT_DATA_WIDTH_8_BIT);
         MockedLCDPort::setup();
     }
     void teardown() override {
         MockedLCDPort::teardown();
-        LCDPort_Deinit();
+        LCDPortSpy_Ops.deinit(NULL);
     }
 };
 
@@ -140,7 +140,7 @@ TEST(AMockedLCDPort8Bit, SetsOutputDataDirectionAndSavesDirectionState) {
     MockPeriphIO_Expect_Write(LCD_FAKE_DIRECTION8_REG,
         LCD_PORT_DATA_DIR_OUTPUT8);
 
-    LCDPort_SetDirection_Output8();
+    LCDPortSpy_Ops.setDirection_Output8(NULL);
     LONGS_EQUAL(LCD_PORT_DATA_DIR_OUTPUT8, LCDPortSpy_GetDataDirection());
 }
 
@@ -149,34 +149,34 @@ TEST(AMockedLCDPort8Bit, SetsInputDataDirectionAndSavesDirectionState) {
         LCD_PORT_DATA_DIR_OUTPUT8);
     MockPeriphIO_Expect_Write(LCD_FAKE_DIRECTION8_REG,
         LCD_PORT_DATA_DIR_INPUT8);
-    LCDPort_SetDirection_Output8();
+    LCDPortSpy_Ops.setDirection_Output8(NULL);
 
-    LCDPort_SetDirection_Input8();
+    LCDPortSpy_Ops.setDirection_Input8(NULL);
     LONGS_EQUAL(LCD_PORT_DATA_DIR_INPUT8, LCDPortSpy_GetDataDirection());
 }
 
 TEST(AMockedLCDPort8Bit, CapturesDataWrites) {
     MockPeriphIO_Expect_Write(LCD_DATA8_ADDR, 0x12341234);
 
-    LCDPort_Out8(0x12341234);
+    LCDPortSpy_Ops.out8(NULL, 0x12341234);
 }
 
 TEST(AMockedLCDPort8Bit, InterceptsDataReads) {
     MockPeriphIO_Expect_ReadThenReturn(LCD_DATA8_ADDR, 0x10002000);
 
-    LONGS_EQUAL(0x10002000, LCDPort_In8());
+    LONGS_EQUAL(0x10002000, LCDPortSpy_Ops.in8(NULL));
 }
 
 /* ====================================================================== */
 TEST_GROUP_BASE(AMockedLCDPort4Bit, MockedLCDPort)
 {
     void setup() override {
-        LCDPort_Init(LCD_PORT_DATA_WIDTH_4_BIT);
+        LCDPortSpy_Ops.init(NULL, LCD_PORT_DATA_WIDTH_4_BIT);
         MockedLCDPort::setup();
     }
     void teardown() override {
         MockedLCDPort::teardown();
-        LCDPort_Deinit();
+        LCDPortSpy_Ops.deinit(NULL);
     }
 };
 
@@ -184,7 +184,7 @@ TEST(AMockedLCDPort4Bit, SetsOutputDataDirectionAndSavesDirectionState) {
     MockPeriphIO_Expect_Write(LCD_FAKE_DIRECTION4_REG,
         LCD_PORT_DATA_DIR_OUTPUT4);
 
-    LCDPort_SetDirection_Output4();
+    LCDPortSpy_Ops.setDirection_Output4(NULL);
     LONGS_EQUAL(LCD_PORT_DATA_DIR_OUTPUT4, LCDPortSpy_GetDataDirection());
 }
 
@@ -193,21 +193,46 @@ TEST(AMockedLCDPort4Bit, SetsInputDataDirectionAndSavesDirectionState) {
         LCD_PORT_DATA_DIR_OUTPUT4);
     MockPeriphIO_Expect_Write(LCD_FAKE_DIRECTION4_REG,
         LCD_PORT_DATA_DIR_INPUT4);
-    LCDPort_SetDirection_Output4();
+    LCDPortSpy_Ops.setDirection_Output4(NULL);
 
-    LCDPort_SetDirection_Input4();
+    LCDPortSpy_Ops.setDirection_Input4(NULL);
     LONGS_EQUAL(LCD_PORT_DATA_DIR_INPUT4, LCDPortSpy_GetDataDirection());
 }
 
 TEST(AMockedLCDPort4Bit, CapturesDataWrites) {
     MockPeriphIO_Expect_Write(LCD_DATA4_ADDR, 0x22224444);
 
-    LCDPort_Out4(0x22224444);
+    LCDPortSpy_Ops.out4(NULL, 0x22224444);
 }
 
 TEST(AMockedLCDPort4Bit, InterceptsDataReads) {
     MockPeriphIO_Expect_ReadThenReturn(LCD_DATA4_ADDR, 0x20002000);
 
-    LONGS_EQUAL(0x20002000, LCDPort_In4());
+    LONGS_EQUAL(0x20002000, LCDPortSpy_Ops.in4(NULL));
 }
 
+#if defined(LCD_PORT_BUS_CYCLES)
+TEST(AMockedLCDPort4Bit, RecordsWriteCycleAndLeavesDataLinesDriven) {
+    MockPeriphIO_Expect_Write(LCD_WRITE_CYCLE_ADDR + LCD_PORT_RS_DATA, 0x5A);
+
+    LCDPortSpy_Ops.writeByte(NULL, LCD_PORT_RS_DATA, 0x5A);
+    LONGS_EQUAL_TEXT(LINE_STATE_ASSERTED, LCDPortSpy_GetRS(), "RS");
+    LONGS_EQUAL_TEXT(LINE_STATE_DEASSERTED, LCDPortSpy_GetRW(), "RW");
+    LONGS_EQUAL(LCD_PORT_DATA_DIR_OUTPUT4, LCDPortSpy_GetDataDirection());
+}
+
+TEST(AMockedLCDPort4Bit, InterceptsReadCycleAndLeavesDataLinesReleased) {
+    MockPeriphIO_Expect_ReadThenReturn(
+        LCD_READ_CYCLE_ADDR + LCD_PORT_RS_INSTRUCTION, 0x80);
+
+    LONGS_EQUAL(0x80, LCDPortSpy_Ops.readByte(NULL, LCD_PORT_RS_INSTRUCTION));
+    LONGS_EQUAL_TEXT(LINE_STATE_DEASSERTED, LCDPortSpy_GetRS(), "RS");
+    LONGS_EQUAL_TEXT(LINE_STATE_ASSERTED, LCDPortSpy_GetRW(), "RW");
+    LONGS_EQUAL(LCD_PORT_DATA_DIR_INPUT4, LCDPortSpy_GetDataDirection());
+}
+#else
+TEST(AMockedLCDPort4Bit, LeavesTheBusCyclesToTheLineOperations) {
+    POINTERS_EQUAL(NULL, (void *)LCDPortSpy_Ops.writeByte);
+    POINTERS_EQUAL(NULL, (void *)LCDPortSpy_Ops.readByte);
+}
+#endif
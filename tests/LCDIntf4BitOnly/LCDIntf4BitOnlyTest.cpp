@@ -0,0 +1,112 @@
+#include "CppUTest/TestHarness.h"
+#include <stdint.h>
+extern "C"
+{
+#include "LCDPort.h"
+#include "LCDIntf.h"
+#include "MockPeriphIO.h"
+};
+#include "LCDPortSpy.h"
+
+#define HI_NIB(byte) ((byte >> 4) & 0x0F)
+#define LO_NIB(byte) (byte & 0x0F)
+
+/* ====================================================================== */
+/*   LCDIntf built with LCD_INTF_DATA_WIDTH=4: the 4-bit implementation   */
+/* is bound at build time and no other width can be selected.  The spy   */
+/* port is bound at build time too (LCDPortInline.h).                     */
+/* ====================================================================== */
+extern "C" void
+Delay_microseconds(uint32_t microseconds)
+{
+}
+
+extern "C" uint32_t
+Timestamp_microseconds(void)
+{
+    return 0;
+}
+
+static LCDIntf intf;
+
+TEST_GROUP(AnLCDIntf_4BitOnly)
+{
+    void setup() override {
+        MockPeriphIO_Create(20);
+        LCDPortSpy_ResetToDefaultState();
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
+    }
+
+    void Expect_Write(int32_t addr, int32_t value) {
+        MockPeriphIO_Expect_Write(addr, value);
+    }
+
+    void Expect_ReadThenReturn(int32_t addr, int32_t value) {
+        MockPeriphIO_Expect_ReadThenReturn(addr, value);
+    }
+};
+
+TEST(AnLCDIntf_4BitOnly, RejectsOtherDataWidth) {
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED,
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT));
+    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_UNDEFINED,
+        LCDIntf_GetPortDataWidth(&intf));
+}
+
+TEST(AnLCDIntf_4BitOnly, AcceptsItsOwnDataWidth) {
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_4_BIT));
+    LONGS_EQUAL(LCD_PORT_DATA_WIDTH_4_BIT, LCDIntf_GetPortDataWidth(&intf));
+}
+
+TEST(AnLCDIntf_4BitOnly, RunsOnThePortBoundAtBuildTime) {
+    int32_t data = 0x5A;
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDIntf_Init(&intf, NULL, NULL, LCD_PORT_DATA_WIDTH_4_BIT));
+    Expect_Write(LCD_RS_ADDR, LINE_STATE_ASSERTED);
+    Expect_Write(LCD_RW_ADDR, LINE_STATE_DEASSERTED);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    Expect_Write(LCD_DATA4_ADDR, HI_NIB(data));
+    Expect_Write(LCD_FAKE_DIRECTION4_REG, LCD_PORT_DATA_DIR_OUTPUT4);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    Expect_Write(LCD_DATA4_ADDR, LO_NIB(data));
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+
+    LCDIntf_WriteData(&intf, data);
+}
+
+TEST(AnLCDIntf_4BitOnly, WritesDataInNibbles) {
+    int32_t data = 0x5A;
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_4_BIT);
+    Expect_Write(LCD_RS_ADDR, LINE_STATE_ASSERTED);
+    Expect_Write(LCD_RW_ADDR, LINE_STATE_DEASSERTED);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    Expect_Write(LCD_DATA4_ADDR, HI_NIB(data));
+    Expect_Write(LCD_FAKE_DIRECTION4_REG, LCD_PORT_DATA_DIR_OUTPUT4);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    Expect_Write(LCD_DATA4_ADDR, LO_NIB(data));
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+
+    LCDIntf_WriteData(&intf, data);
+}
+
+TEST(AnLCDIntf_4BitOnly, ReadsStatusInNibbles) {
+    LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_4_BIT);
+    Expect_Write(LCD_RS_ADDR, LINE_STATE_DEASSERTED);
+    Expect_Write(LCD_RW_ADDR, LINE_STATE_ASSERTED);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    Expect_ReadThenReturn(LCD_DATA4_ADDR, 0x0);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    Expect_ReadThenReturn(LCD_DATA4_ADDR, 0x0);
+    Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+}
@@ -0,0 +1,118 @@
+#ifndef D_LCDPortInline_h
+#define D_LCDPortInline_h
+
+/*   Binds LCDIntf to the spy port at build time.  The spy keeps its
+ * operations static, so they are reached through its table here; that is
+ * enough to tell the binding from the table passed to LCDIntf_Init().
+ */
+extern const LCDPortOps LCDPortSpy_Ops;
+
+static inline void
+LCDPortInline_init(void * port, int32_t lcdPortDataWidth)
+{
+    LCDPortSpy_Ops.init(port, lcdPortDataWidth);
+}
+
+static inline void
+LCDPortInline_deinit(void * port)
+{
+    LCDPortSpy_Ops.deinit(port);
+}
+
+static inline void
+LCDPortInline_setDirection_Input8(void * port)
+{
+    LCDPortSpy_Ops.setDirection_Input8(port);
+}
+
+static inline void
+LCDPortInline_setDirection_Output8(void * port)
+{
+    LCDPortSpy_Ops.setDirection_Output8(port);
+}
+
+static inline void
+LCDPortInline_setDirection_Input4(void * port)
+{
+    LCDPortSpy_Ops.setDirection_Input4(port);
+}
+
+static inline void
+LCDPortInline_setDirection_Output4(void * port)
+{
+    LCDPortSpy_Ops.setDirection_Output4(port);
+}
+
+static inline void
+LCDPortInline_out4(void * port, int32_t n)
+{
+    LCDPortSpy_Ops.out4(port, n);
+}
+
+static inline void
+LCDPortInline_out8(void * port, int32_t n)
+{
+    LCDPortSpy_Ops.out8(port, n);
+}
+
+static inline int32_t
+LCDPortInline_in4(void * port)
+{
+    return LCDPortSpy_Ops.in4(port);
+}
+
+static inline int32_t
+LCDPortInline_in8(void * port)
+{
+    return LCDPortSpy_Ops.in8(port);
+}
+
+static inline void
+LCDPortInline_setRS(void * port)
+{
+    LCDPortSpy_Ops.setRS(port);
+}
+
+static inline void
+LCDPortInline_clearRS(void * port)
+{
+    LCDPortSpy_Ops.clearRS(port);
+}
+
+static inline void
+LCDPortInline_setRW(void * port)
+{
+    LCDPortSpy_Ops.setRW(port);
+}
+
+static inline void
+LCDPortInline_clearRW(void * port)
+{
+    LCDPortSpy_Ops.clearRW(port);
+}
+
+static inline void
+LCDPortInline_setCE(void * port)
+{
+    LCDPortSpy_Ops.setCE(port);
+}
+
+static inline void
+LCDPortInline_clearCE(void * port)
+{
+    LCDPortSpy_Ops.clearCE(port);
+}
+
+static inline void
+LCDPortInline_writeByte(void * port, int32_t rs, int32_t value)
+{
+    LCDPortSpy_Ops.writeByte(port, rs, value);
+}
+
+static inline int32_t
+LCDPortInline_readByte(void * port, int32_t rs)
+{
+    return LCDPortSpy_Ops.readByte(port, rs);
+}
+
+#endif /* #ifndef D_LCDPortInline_h */
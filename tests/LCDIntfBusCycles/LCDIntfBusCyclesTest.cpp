@@ -0,0 +1,197 @@
+#include "CppUTest/TestHarness.h"
+#include <stdint.h>
+extern "C"
+{
+#include "LCDPort.h"
+#include "LCDIntf.h"
+#include "MockPeriphIO.h"
+};
+#include "LCDPortSpy.h"
+
+/* ====================================================================== */
+/*   LCDIntf built against a port with whole bus cycles: every transfer   */
+/* has to reach the port as a single call.                                */
+/* ====================================================================== */
+extern "C" void
+Delay_microseconds(uint32_t microseconds)
+{
+}
+
+// every look at the clock takes a microsecond, so busy waits run out
+static uint32_t fakeMicroseconds = 0;
+
+extern "C" uint32_t
+Timestamp_microseconds(void)
+{
+    return ++fakeMicroseconds;
+}
+
+static LCDIntf intf;
+
+class LCDIntf_BusCycles : public Utest
+{
+public:
+    void teardown() override {
+        LCDIntf_Deinit(&intf);
+        MockPeriphIO_Verify_Complete();
+        MockPeriphIO_Destroy();
+    }
+
+    void Expect_WriteCycle(int32_t rs, int32_t value) {
+        MockPeriphIO_Expect_Write(LCD_WRITE_CYCLE_ADDR + rs, value);
+    }
+
+    void Expect_ReadCycleThenReturn(int32_t rs, int32_t value) {
+        MockPeriphIO_Expect_ReadThenReturn(LCD_READ_CYCLE_ADDR + rs, value);
+    }
+};
+
+TEST_GROUP_BASE(AnLCDIntf_8BitBusCycles, LCDIntf_BusCycles)
+{
+    void setup() override {
+        MockPeriphIO_Create(10);
+        LCDPortSpy_ResetToDefaultState();
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+    }
+};
+
+TEST(AnLCDIntf_8BitBusCycles, WritesInstructionInOneCycle) {
+    Expect_WriteCycle(LCD_PORT_RS_INSTRUCTION, DISPLAY_CLEAR);
+
+    LCDIntf_WriteInstruction(&intf, DISPLAY_CLEAR);
+}
+
+TEST(AnLCDIntf_8BitBusCycles, WritesDataInOneCycle) {
+    Expect_WriteCycle(LCD_PORT_RS_DATA, 0xA5);
+
+    LCDIntf_WriteData(&intf, 0xA5);
+}
+
+TEST(AnLCDIntf_8BitBusCycles, ReadsDataInOneCycle) {
+    Expect_ReadCycleThenReturn(LCD_PORT_RS_DATA, 0x3C);
+
+    LONGS_EQUAL(0x3C, LCDIntf_ReadData(&intf));
+}
+
+TEST(AnLCDIntf_8BitBusCycles, ReadsStatusUntilControllerIsReady) {
+    Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+        READ_INSTRUCTION__BUSY_FLAG);
+    Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+        READ_INSTRUCTION__NO_BUSY_FLAG);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+}
+
+TEST(AnLCDIntf_8BitBusCycles, GivesUpOnBusyControllerEventually) {
+    for (int i = 0; i < LCD_BUSY_TIMEOUT_SHORT_US; ++i) {
+        Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+            READ_INSTRUCTION__BUSY_FLAG);
+    }
+
+    LONGS_EQUAL(LCD_OPERATION_TIMEOUT, LCDIntf_WaitWhileBusy(&intf));
+}
+
+TEST(AnLCDIntf_8BitBusCycles, ServesQueuedOperationsWithBusCycles) {
+    Expect_WriteCycle(LCD_PORT_RS_DATA, 'a');
+    Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+        READ_INSTRUCTION__NO_BUSY_FLAG);
+
+    LCDIntf_QueueData(&intf, 'a');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Drain(&intf));
+}
+
+TEST(AnLCDIntf_8BitBusCycles, WritesBurstByteByByte) {
+    const uint8_t burst[] = { 'a', 'b' };
+
+    Expect_WriteCycle(LCD_PORT_RS_DATA, 'a');
+    Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+        READ_INSTRUCTION__NO_BUSY_FLAG);
+    Expect_WriteCycle(LCD_PORT_RS_DATA, 'b');
+    Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+        READ_INSTRUCTION__NO_BUSY_FLAG);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WriteDataBurst(&intf, burst, 2));
+}
+
+TEST(AnLCDIntf_8BitBusCycles, InitializesControllerWithBusCycles) {
+    const int32_t instructions[] = {
+        DISPLAY_CONTROL__D_ON_C_OFF_B_OFF, DISPLAY_CLEAR,
+        ENTRY_MODE_SET__I_D_SH
+    };
+    Expect_WriteCycle(LCD_PORT_RS_INSTRUCTION,
+        FUNCTION_SET__8BIT_2LINE_8x11FONT);
+    Expect_WriteCycle(LCD_PORT_RS_INSTRUCTION,
+        FUNCTION_SET__8BIT_2LINE_8x11FONT);
+    for (int i = 0; i < 3; ++i) {
+        Expect_WriteCycle(LCD_PORT_RS_INSTRUCTION, instructions[i]);
+        Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+            READ_INSTRUCTION__NO_BUSY_FLAG);
+    }
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_InitializeLCDController(&intf));
+}
+
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDIntf_4BitBusCycles, LCDIntf_BusCycles)
+{
+    void setup() override {
+        MockPeriphIO_Create(10);
+        LCDPortSpy_ResetToDefaultState();
+        LCDIntf_Init(&intf, &LCDPortSpy_Ops, NULL, LCD_PORT_DATA_WIDTH_4_BIT);
+    }
+};
+
+TEST(AnLCDIntf_4BitBusCycles, LeavesNibbleSplittingToThePort) {
+    Expect_WriteCycle(LCD_PORT_RS_DATA, 0xA5);
+
+    LCDIntf_WriteData(&intf, 0xA5);
+}
+
+TEST(AnLCDIntf_4BitBusCycles, ReadsStatusInOneCycle) {
+    Expect_ReadCycleThenReturn(LCD_PORT_RS_INSTRUCTION,
+        READ_INSTRUCTION__NO_BUSY_FLAG);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+}
+
+/* ====================================================================== */
+/*   The same build, a table without the bus cycles: the instance falls  */
+/* back to the per line operations.                                       */
+/* ====================================================================== */
+TEST_GROUP_BASE(AnLCDIntf_WithoutBusCycles, LCDIntf_BusCycles)
+{
+    LCDPortOps lineOps;
+
+    void setup() override {
+        MockPeriphIO_Create(10);
+        LCDPortSpy_ResetToDefaultState();
+        lineOps = LCDPortSpy_Ops;
+        lineOps.writeByte = NULL;
+        lineOps.readByte = NULL;
+        LCDIntf_Init(&intf, &lineOps, NULL, LCD_PORT_DATA_WIDTH_8_BIT);
+    }
+};
+
+TEST(AnLCDIntf_WithoutBusCycles, WritesDataLineByLine) {
+    MockPeriphIO_Expect_Write(LCD_RS_ADDR, LINE_STATE_ASSERTED);
+    MockPeriphIO_Expect_Write(LCD_RW_ADDR, LINE_STATE_DEASSERTED);
+    MockPeriphIO_Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    MockPeriphIO_Expect_Write(LCD_DATA8_ADDR, 0xA5);
+    MockPeriphIO_Expect_Write(LCD_FAKE_DIRECTION8_REG,
+        LCD_PORT_DATA_DIR_OUTPUT8);
+    MockPeriphIO_Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+
+    LCDIntf_WriteData(&intf, 0xA5);
+}
+
+TEST(AnLCDIntf_WithoutBusCycles, ReadsStatusLineByLine) {
+    MockPeriphIO_Expect_Write(LCD_RS_ADDR, LINE_STATE_DEASSERTED);
+    MockPeriphIO_Expect_Write(LCD_RW_ADDR, LINE_STATE_ASSERTED);
+    MockPeriphIO_Expect_Write(LCD_CE_ADDR, LINE_STATE_ASSERTED);
+    MockPeriphIO_Expect_ReadThenReturn(LCD_DATA8_ADDR,
+        READ_INSTRUCTION__NO_BUSY_FLAG);
+    MockPeriphIO_Expect_Write(LCD_CE_ADDR, LINE_STATE_DEASSERTED);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WaitWhileBusy(&intf));
+}
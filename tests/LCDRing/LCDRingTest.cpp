@@ -0,0 +1,173 @@
+#include "CppUTest/TestHarness.h"
+#include <pthread.h>
+#include <sched.h>
+
+extern "C" {
+#include "LCDRing.h"
+}
+
+enum {
+    RING_SIZE = 8,
+};
+
+TEST_GROUP(AnLCDRing)
+{
+    uint16_t storage[RING_SIZE];
+    LCDRing ring;
+
+    void setup() override {
+        LCDRing_Init(&ring, storage, RING_SIZE);
+    }
+
+    void teardown() override {
+    }
+};
+
+TEST(AnLCDRing, RejectsSizeThatIsNotPowerOfTwo) {
+    LONGS_EQUAL(LCD_RING_BAD_SIZE, LCDRing_Init(&ring, storage, 6));
+    LONGS_EQUAL(LCD_RING_BAD_SIZE, LCDRing_Init(&ring, storage, 0));
+}
+
+TEST(AnLCDRing, IsEmptyAfterInit) {
+    uint16_t entry;
+
+    LONGS_EQUAL(0, LCDRing_GetLength(&ring));
+    LONGS_EQUAL(LCD_RING_EMPTY, LCDRing_Peek(&ring, &entry));
+}
+
+TEST(AnLCDRing, ReturnsEntriesInOrder) {
+    uint16_t entry;
+
+    LCDRing_Put(&ring, 0x101);
+    LCDRing_Put(&ring, 0x002);
+
+    LONGS_EQUAL(LCD_RING_OK, LCDRing_Peek(&ring, &entry));
+    LONGS_EQUAL(0x101, entry);
+    LCDRing_Drop(&ring);
+    LONGS_EQUAL(LCD_RING_OK, LCDRing_Peek(&ring, &entry));
+    LONGS_EQUAL(0x002, entry);
+    LCDRing_Drop(&ring);
+    LONGS_EQUAL(LCD_RING_EMPTY, LCDRing_Peek(&ring, &entry));
+}
+
+TEST(AnLCDRing, PeekLeavesEntryInPlace) {
+    uint16_t entry;
+
+    LCDRing_Put(&ring, 'a');
+    LCDRing_Peek(&ring, &entry);
+
+    LONGS_EQUAL(1, LCDRing_GetLength(&ring));
+}
+
+TEST(AnLCDRing, CountsOverflows) {
+    for (int i = 0; i < RING_SIZE; ++i)
+        LONGS_EQUAL(LCD_RING_OK, LCDRing_Put(&ring, i));
+
+    LONGS_EQUAL(LCD_RING_FULL, LCDRing_Put(&ring, 'x'));
+    LONGS_EQUAL(LCD_RING_FULL, LCDRing_Put(&ring, 'y'));
+    LONGS_EQUAL(2, LCDRing_GetOverflows(&ring));
+    LONGS_EQUAL(RING_SIZE, LCDRing_GetLength(&ring));
+}
+
+TEST(AnLCDRing, TracksHighWatermark) {
+    uint16_t entry;
+
+    LCDRing_Put(&ring, 1);
+    LCDRing_Put(&ring, 2);
+    LCDRing_Put(&ring, 3);
+    LCDRing_Peek(&ring, &entry);
+    LCDRing_Drop(&ring);
+    LCDRing_Put(&ring, 4);
+
+    LONGS_EQUAL(3, LCDRing_GetHighWatermark(&ring));
+}
+
+TEST(AnLCDRing, WrapsAroundStorage) {
+    uint16_t entry;
+
+    for (int i = 0; i < 3 * RING_SIZE; ++i) {
+        LCDRing_Put(&ring, i);
+        LCDRing_Peek(&ring, &entry);
+        LONGS_EQUAL(i, entry);
+        LCDRing_Drop(&ring);
+    }
+}
+
+TEST(AnLCDRing, FlushEmptiesTheRing) {
+    LCDRing_Put(&ring, 1);
+    LCDRing_Put(&ring, 2);
+
+    LCDRing_Flush(&ring);
+
+    LONGS_EQUAL(0, LCDRing_GetLength(&ring));
+}
+
+/* ====================================================================== */
+/*   Producer thread plays the application, consumer thread plays the timer
+ * ISR.  Every entry has to arrive exactly once and in order.
+ */
+enum {
+    ENTRIES_TO_PASS = 200000,
+};
+
+struct RingSharedByThreads {
+    LCDRing ring;
+    uint16_t storage[RING_SIZE];
+    uint32_t mismatches;
+};
+
+static void *
+producer(void * arg)
+{
+    RingSharedByThreads * shared = (RingSharedByThreads *)arg;
+
+    for (uint32_t i = 0; i < ENTRIES_TO_PASS; ) {
+        if (LCD_RING_OK == LCDRing_Put(&shared->ring, (uint16_t)i))
+            ++i;
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void *
+consumer(void * arg)
+{
+    RingSharedByThreads * shared = (RingSharedByThreads *)arg;
+    uint16_t entry;
+
+    for (uint32_t i = 0; i < ENTRIES_TO_PASS; ) {
+        if (LCD_RING_OK != LCDRing_Peek(&shared->ring, &entry)) {
+            sched_yield();
+            continue;
+        }
+        if (entry != (uint16_t)i)
+            ++shared->mismatches;
+        LCDRing_Drop(&shared->ring);
+        ++i;
+    }
+
+    return NULL;
+}
+
+TEST_GROUP(AnLCDRing_Threaded)
+{
+};
+
+TEST(AnLCDRing_Threaded, PassesEveryEntryFromProducerToConsumer) {
+    RingSharedByThreads shared;
+    pthread_t producerThread, consumerThread;
+
+    LCDRing_Init(&shared.ring, shared.storage, RING_SIZE);
+    shared.mismatches = 0;
+
+    pthread_create(&consumerThread, NULL, consumer, &shared);
+    pthread_create(&producerThread, NULL, producer, &shared);
+    pthread_join(producerThread, NULL);
+    pthread_join(consumerThread, NULL);
+
+    LONGS_EQUAL(0, shared.mismatches);
+    LONGS_EQUAL(0, LCDRing_GetLength(&shared.ring));
+    CHECK(LCDRing_GetHighWatermark(&shared.ring) <= RING_SIZE);
+}
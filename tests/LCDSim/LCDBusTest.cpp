@@ -0,0 +1,314 @@
+#include "CppUTest/TestHarness.h"
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+#include "LCDIntf.h"
+#include "LCDBus.h"
+#include "LCDSim.h"
+}
+
+/* ====================================================================== */
+/*   Simulated controllers on common RS/RW and data lines, each with an   */
+/* E line of its own.                                                     */
+/* ====================================================================== */
+enum {
+    DISPLAYS_ON_BUS = LCD_BUS_MAX_DISPLAYS,
+    TEXT_LENGTH = 16,
+};
+
+TEST_GROUP(AnLCDBus)
+{
+    LCDSimLines lines;
+    LCDSim sims[DISPLAYS_ON_BUS];
+    LCDIntf intfs[DISPLAYS_ON_BUS];
+    LCDBus bus;
+    char texts[DISPLAYS_ON_BUS][TEXT_LENGTH + 1];
+
+    void setup() override {
+        memset(&lines, 0, sizeof(lines));
+        LCDBus_Init(&bus);
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i) {
+            LCDSim_Init(&sims[i]);
+            LCDSim_AttachToLines(&sims[i], &lines);
+            LCDIntf_Init(&intfs[i], &LCDSim_Ops, &sims[i],
+                LCD_PORT_DATA_WIDTH_8_BIT);
+            LCDIntf_InitializeLCDController(&intfs[i]);
+            LONGS_EQUAL(LCD_OPERATION_OK, LCDBus_Attach(&bus, &intfs[i]));
+
+            memset(texts[i], 'A' + i, TEXT_LENGTH);
+            texts[i][TEXT_LENGTH] = '\0';
+        }
+    }
+
+    void teardown() override {
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+            LCDIntf_Deinit(&intfs[i]);
+    }
+
+    void queueText(int i, const char * text) {
+        LCDIntf_QueueInstruction(&intfs[i], SET_DDRAM_ADDRESS_CMD);
+        for (; *text; ++text)
+            LCDIntf_QueueData(&intfs[i], *text);
+    }
+
+    void queueAllTexts() {
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+            queueText(i, texts[i]);
+    }
+
+    uint32_t refreshOneAfterAnother() {
+        uint32_t before = lines.overlappedWrites;
+
+        queueAllTexts();
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+            LCDIntf_Drain(&intfs[i]);
+
+        return lines.overlappedWrites - before;
+    }
+
+    uint32_t refreshOverTheBus() {
+        uint32_t before = lines.overlappedWrites;
+
+        queueAllTexts();
+        LCDBus_Drain(&bus);
+
+        return lines.overlappedWrites - before;
+    }
+};
+
+TEST(AnLCDBus, RejectsDisplaysBeyondItsCapacity) {
+    LCDIntf extra;
+
+    LCDIntf_Init(&extra, &LCDSim_Ops, &sims[0], LCD_PORT_DATA_WIDTH_8_BIT);
+
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED, LCDBus_Attach(&bus, &extra));
+}
+
+TEST(AnLCDBus, CannotBroadcastWithoutBroadcastInterface) {
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED,
+        LCDBus_BroadcastInstruction(&bus, DISPLAY_CLEAR));
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED,
+        LCDBus_InitializeLCDControllers(&bus));
+}
+
+TEST(AnLCDBus, IsDoneWhenNothingIsQueued) {
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDBus_Poll(&bus));
+}
+
+TEST(AnLCDBus, StaysPendingWhileAnyDisplayHasWorkLeft) {
+    queueText(DISPLAYS_ON_BUS - 1, "x");
+
+    LONGS_EQUAL(LCD_OPERATION_PENDING, LCDBus_Poll(&bus));
+}
+
+TEST(AnLCDBus, GivesEveryDisplayItsOwnText) {
+    queueAllTexts();
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDBus_Drain(&bus));
+
+    for (int i = 0; i < DISPLAYS_ON_BUS; ++i) {
+        MEMCMP_EQUAL(texts[i], sims[i].ddram, TEXT_LENGTH);
+        LONGS_EQUAL(0, sims[i].writesWhileBusy);
+    }
+    LONGS_EQUAL(0, lines.floatingWrites);
+}
+
+/*   A busy flag poll of one display releases the data lines the others
+ * write through; the direction is shared, so the next write drives them
+ * again.
+ */
+TEST(AnLCDBus, TurnsSharedDataLinesAroundForEveryDisplay) {
+    queueAllTexts();
+    LCDBus_Drain(&bus);
+    queueAllTexts();
+
+    LCDBus_Drain(&bus);
+
+    LONGS_EQUAL(0, lines.floatingWrites);
+}
+
+/*   Counted by the simulators, not timed: a pass of the bus writes every
+ * display that is seen ready, the later ones while the earlier execute.
+ */
+TEST(AnLCDBus, OverlapsBusyWindowsOfItsDisplays) {
+    uint32_t oneAfterAnother = refreshOneAfterAnother();
+    uint32_t overTheBus = refreshOverTheBus();
+
+    LONGS_EQUAL(0, oneAfterAnother);
+    CHECK(overTheBus > TEXT_LENGTH);
+    for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+        LONGS_EQUAL(0, sims[i].writesWhileBusy);
+}
+
+/* ====================================================================== */
+/*   The same bus with a port raising all E lines together; the displays */
+/* alternate between polled and predicted readiness.                      */
+/* ====================================================================== */
+TEST_GROUP(AnLCDBus_Broadcasting)
+{
+    LCDSimLines lines;
+    LCDSim sims[DISPLAYS_ON_BUS];
+    LCDIntf intfs[DISPLAYS_ON_BUS];
+    LCDSimGroup everySim;
+    LCDIntf all;
+    LCDBus bus;
+
+    void setup() override {
+        memset(&lines, 0, sizeof(lines));
+        LCDSimGroup_Init(&everySim);
+        LCDBus_Init(&bus);
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i) {
+            LCDSim_Init(&sims[i]);
+            LCDSim_AttachToLines(&sims[i], &lines);
+            LCDSimGroup_Add(&everySim, &sims[i]);
+            LCDIntf_Init(&intfs[i], &LCDSim_Ops, &sims[i],
+                LCD_PORT_DATA_WIDTH_8_BIT);
+            LCDIntf_SetBusyMode(&intfs[i], (i & 0x01) ?
+                LCD_BUSY_MODE_PREDICT : LCD_BUSY_MODE_POLL);
+            LCDBus_Attach(&bus, &intfs[i]);
+        }
+        LCDIntf_Init(&all, &LCDSimGroup_Ops, &everySim,
+            LCD_PORT_DATA_WIDTH_8_BIT);
+        LONGS_EQUAL(LCD_OPERATION_OK, LCDBus_SetBroadcast(&bus, &all));
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&all);
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+            LCDIntf_Deinit(&intfs[i]);
+    }
+
+    void fillEveryDisplay() {
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i) {
+            LCDIntf_QueueInstruction(&intfs[i], SET_DDRAM_ADDRESS_CMD);
+            for (int j = 0; j < TEXT_LENGTH; ++j)
+                LCDIntf_QueueData(&intfs[i], '0' + i);
+        }
+    }
+
+    void scribbleOnEveryDisplay() {
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+            memset(sims[i].ddram, 'x', sizeof(sims[i].ddram));
+    }
+
+    void checkEveryDisplayIsInitializedAndBlank() {
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i) {
+            CHECK(sims[i].transfers > 0);
+            LONGS_EQUAL(LCD_INIT_FUNCTION_SET | FUNCTION_SET__8BIT,
+                sims[i].functionSet);
+            LONGS_EQUAL(LCD_INIT_DISPLAY_CONTROL, sims[i].displayControl);
+            MEMCMP_EQUAL("                ", &sims[i].ddram[0x00],
+                TEXT_LENGTH);
+            MEMCMP_EQUAL("                ", &sims[i].ddram[0x40],
+                TEXT_LENGTH);
+        }
+    }
+
+    void checkNoDisplayWasWrittenWhileBusy() {
+        for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+            LONGS_EQUAL(0, sims[i].writesWhileBusy);
+        LONGS_EQUAL(0, lines.floatingWrites);
+        LONGS_EQUAL(0, everySim.collisions);
+    }
+
+    uint32_t bringUpAndClearOne() {
+        uint32_t start = Timestamp_microseconds();
+
+        LCDIntf_InitializeLCDController(&intfs[0]);
+        LCDIntf_WriteInstruction(&intfs[0], DISPLAY_CLEAR);
+        LCDIntf_WaitWhileBusy(&intfs[0]);
+
+        return Timestamp_microseconds() - start;
+    }
+
+    uint32_t bringUpAndClearAll() {
+        uint32_t start;
+
+        scribbleOnEveryDisplay();
+        start = Timestamp_microseconds();
+
+        LCDBus_InitializeLCDControllers(&bus);
+        LCDBus_BroadcastInstruction(&bus, DISPLAY_CLEAR);
+
+        return Timestamp_microseconds() - start;
+    }
+};
+
+TEST(AnLCDBus_Broadcasting, InitializesEveryControllerAtOnce) {
+    scribbleOnEveryDisplay();
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDBus_InitializeLCDControllers(&bus));
+
+    checkEveryDisplayIsInitializedAndBlank();
+    for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+        LONGS_EQUAL(sims[0].transfers, sims[i].transfers);
+    checkNoDisplayWasWrittenWhileBusy();
+}
+
+TEST(AnLCDBus_Broadcasting, LeavesEveryControllerReadyForData) {
+    const uint8_t title[] = { 'O', 'K' };
+
+    LCDBus_InitializeLCDControllers(&bus);
+
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDBus_BroadcastDataBurst(&bus, title, sizeof(title)));
+
+    for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+        MEMCMP_EQUAL("OK", sims[i].ddram, sizeof(title));
+    checkNoDisplayWasWrittenWhileBusy();
+}
+
+TEST(AnLCDBus_Broadcasting, ClearsEveryDisplayWithOneInstruction) {
+    LCDBus_InitializeLCDControllers(&bus);
+    fillEveryDisplay();
+
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDBus_BroadcastInstruction(&bus, DISPLAY_CLEAR));
+
+    for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+        MEMCMP_EQUAL("                ", sims[i].ddram, TEXT_LENGTH);
+    checkNoDisplayWasWrittenWhileBusy();
+}
+
+TEST(AnLCDBus_Broadcasting, WritesIdenticalContentToEveryDisplay) {
+    const uint8_t title[] = { 'M', 'e', 'n', 'u' };
+
+    LCDBus_InitializeLCDControllers(&bus);
+    LCDBus_BroadcastInstruction(&bus, SET_DDRAM_ADDRESS_CMD | 0x40);
+
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDBus_BroadcastDataBurst(&bus, title, sizeof(title)));
+
+    for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+        MEMCMP_EQUAL("Menu", &sims[i].ddram[0x40], sizeof(title));
+    checkNoDisplayWasWrittenWhileBusy();
+}
+
+TEST(AnLCDBus_Broadcasting, LetsDisplaysGoOnOnTheirOwnAfterwards) {
+    LCDBus_InitializeLCDControllers(&bus);
+    LCDBus_BroadcastInstruction(&bus, DISPLAY_CLEAR);
+
+    fillEveryDisplay();
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDBus_Drain(&bus));
+
+    for (int i = 0; i < DISPLAYS_ON_BUS; ++i)
+        LONGS_EQUAL('0' + i, sims[i].ddram[TEXT_LENGTH - 1]);
+    checkNoDisplayWasWrittenWhileBusy();
+}
+
+/*   Best of a few runs, to keep the host scheduler out of the figures. */
+TEST(AnLCDBus_Broadcasting, BringsUpAndClearsAllAboutAsFastAsOne) {
+    uint32_t one = UINT32_MAX, all = UINT32_MAX, t;
+
+    for (int run = 0; run < 3; ++run) {
+        if ((t = bringUpAndClearOne()) < one)
+            one = t;
+        if ((t = bringUpAndClearAll()) < all)
+            all = t;
+    }
+
+    CHECK(4 * all < 5 * one);
+    checkEveryDisplayIsInitializedAndBlank();
+    checkNoDisplayWasWrittenWhileBusy();
+}
@@ -0,0 +1,517 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include "LCDIntf.h"
+#include "LCDSim.h"
+
+static void init(void * port, int32_t lcdPortDataWidth);
+static void deinit(void * port);
+static void setDirection_Input(void * port);
+static void setDirection_Output(void * port);
+static void out4(void * port, int32_t n);
+static void out8(void * port, int32_t n);
+static int32_t in4(void * port);
+static int32_t in8(void * port);
+static void setRS(void * port);
+static void clearRS(void * port);
+static void setRW(void * port);
+static void clearRW(void * port);
+static void setCE(void * port);
+static void clearCE(void * port);
+static void writeByte(void * port, int32_t rs, int32_t value);
+static int32_t readByte(void * port, int32_t rs);
+static LCDSim * operate(void * port);
+static void latchWrite(LCDSim * sim, int32_t value);
+static void driveDataLines(LCDSimLines * lines, int8_t hostDriving);
+static void executeInstruction(LCDSim * sim, int32_t instr);
+static void advanceAddressCounter(LCDSim * sim);
+static int32_t readRegister(LCDSim * sim);
+
+static void groupInit(void * port, int32_t lcdPortDataWidth);
+static void groupDeinit(void * port);
+static void groupSetDirection_Input(void * port);
+static void groupSetDirection_Output(void * port);
+static void groupOut4(void * port, int32_t n);
+static void groupOut8(void * port, int32_t n);
+static int32_t groupIn4(void * port);
+static int32_t groupIn8(void * port);
+static void groupSetRS(void * port);
+static void groupClearRS(void * port);
+static void groupSetRW(void * port);
+static void groupClearRW(void * port);
+static void groupSetCE(void * port);
+static void groupClearCE(void * port);
+static void forEachInGroup(LCDSimGroup * group, void (*op)(void *));
+static LCDSim * answerOfGroup(LCDSimGroup * group);
+
+const LCDPortOps LCDSim_Ops = {
+    init, deinit,
+    setDirection_Input, setDirection_Output,
+    setDirection_Input, setDirection_Output,
+    out4, out8, in4, in8,
+    setRS, clearRS, setRW, clearRW, setCE, clearCE,
+    NULL, NULL
+};
+
+const LCDPortOps LCDSim_BusCycleOps = {
+    init, deinit,
+    setDirection_Input, setDirection_Output,
+    setDirection_Input, setDirection_Output,
+    out4, out8, in4, in8,
+    setRS, clearRS, setRW, clearRW, setCE, clearCE,
+    writeByte, readByte
+};
+
+const LCDPortOps LCDSimGroup_Ops = {
+    groupInit, groupDeinit,
+    groupSetDirection_Input, groupSetDirection_Output,
+    groupSetDirection_Input, groupSetDirection_Output,
+    groupOut4, groupOut8, groupIn4, groupIn8,
+    groupSetRS, groupClearRS, groupSetRW, groupClearRW,
+    groupSetCE, groupClearCE,
+    NULL, NULL
+};
+
+enum {
+    DDRAM_2ND_LINE_ADDR = 0x40,
+    DDRAM_1ST_LINE_LAST_ADDR = 0x27,
+    DDRAM_2ND_LINE_LAST_ADDR = 0x67,
+    DDRAM_LINE_LENGTH = 40,
+    DISPLAY_CONTROL = 0x08,
+};
+
+/* ==== Public Interface ================================================ */
+
+void
+LCDSim_Init(LCDSim * sim)
+{
+    memset(sim, 0, sizeof(*sim));
+    memset(sim->ddram, ' ', sizeof(sim->ddram));
+    sim->lines = &sim->ownLines;
+    sim->busyUntil = Timestamp_microseconds();
+}
+
+void
+LCDSim_AttachToLines(LCDSim * sim, LCDSimLines * lines)
+{
+    sim->lines = lines;
+}
+
+int32_t
+LCDSim_IsBusy(LCDSim * sim)
+{
+    return (int32_t)(Timestamp_microseconds() - sim->busyUntil) < 0;
+}
+
+/*   What column of line 0 or 1 shows, with the display shift applied. */
+uint8_t
+LCDSim_ShownChar(LCDSim * sim, int16_t line, int16_t column)
+{
+    column = (column + sim->displayShift) % DDRAM_LINE_LENGTH;
+
+    return sim->ddram[line * DDRAM_2ND_LINE_ADDR + column];
+}
+
+void
+LCDSimGroup_Init(LCDSimGroup * group)
+{
+    memset(group, 0, sizeof(*group));
+}
+
+int32_t
+LCDSimGroup_Add(LCDSimGroup * group, LCDSim * sim)
+{
+    if (LCDSIM_GROUP_SIZE <= group->count)
+        return LCD_OPERATION_UNSUPPORTED;
+
+    group->sims[group->count++] = sim;
+
+    return LCD_OPERATION_OK;
+}
+
+/* ==== Private Implementation ========================================== */
+
+static void
+init(void * port, int32_t lcdPortDataWidth)
+{
+    LCDSim * sim = port;
+
+    sim->lines->rs = 0;
+    sim->lines->rw = 1;
+    sim->lines->hostDriving = 0;
+    sim->ce = 0;
+}
+
+static void
+deinit(void * port)
+{
+}
+
+static void
+setDirection_Input(void * port)
+{
+    driveDataLines(operate(port)->lines, 0);
+}
+
+static void
+setDirection_Output(void * port)
+{
+    driveDataLines(operate(port)->lines, 1);
+}
+
+static void
+out4(void * port, int32_t n)
+{
+    LCDSim * sim = operate(port);
+
+    sim->lines->dataLines = (n & 0x0F) << 4;
+}
+
+static void
+out8(void * port, int32_t n)
+{
+    LCDSim * sim = operate(port);
+
+    sim->lines->dataLines = n & 0xFF;
+}
+
+static int32_t
+in4(void * port)
+{
+    return (readRegister(operate(port)) >> 4) & 0x0F;
+}
+
+static int32_t
+in8(void * port)
+{
+    return readRegister(operate(port));
+}
+
+static void
+setRS(void * port)
+{
+    operate(port)->lines->rs = 1;
+}
+
+static void
+clearRS(void * port)
+{
+    operate(port)->lines->rs = 0;
+}
+
+static void
+setRW(void * port)
+{
+    operate(port)->lines->rw = 1;
+}
+
+static void
+clearRW(void * port)
+{
+    operate(port)->lines->rw = 0;
+}
+
+static void
+setCE(void * port)
+{
+    operate(port)->ce = 1;
+}
+
+/*   The falling edge of E completes the transfer. */
+static void
+clearCE(void * port)
+{
+    LCDSim * sim = operate(port);
+
+    if (!sim->ce)
+        return;
+    sim->ce = 0;
+
+    if (!sim->lines->rw) {
+        latchWrite(sim, sim->lines->dataLines);
+    } else if (sim->lines->rs && !sim->cgramSelected) {
+        advanceAddressCounter(sim);
+    }
+}
+
+static void
+writeByte(void * port, int32_t rs, int32_t value)
+{
+    LCDSim * sim = operate(port);
+
+    sim->lines->rs = rs;
+    sim->lines->rw = 0;
+    driveDataLines(sim->lines, 1);
+    latchWrite(sim, value & 0xFF);
+}
+
+static int32_t
+readByte(void * port, int32_t rs)
+{
+    LCDSim * sim = operate(port);
+    int32_t v;
+
+    sim->lines->rs = rs;
+    sim->lines->rw = 1;
+    driveDataLines(sim->lines, 0);
+    v = readRegister(sim);
+    if (rs && !sim->cgramSelected)
+        advanceAddressCounter(sim);
+
+    return v;
+}
+
+/*   Every port operation but init and deinit is counted. */
+static LCDSim *
+operate(void * port)
+{
+    LCDSim * sim = port;
+
+    ++sim->portOperations;
+
+    return sim;
+}
+
+static void
+latchWrite(LCDSim * sim, int32_t value)
+{
+    uint32_t executionTime = LCD_EXECUTION_TIME_SHORT_US;
+
+    if (LCDSim_IsBusy(sim))
+        ++sim->writesWhileBusy;
+    if (!sim->lines->hostDriving)
+        ++sim->lines->floatingWrites;
+    if (sim->lines->executing > sim->executing)
+        ++sim->lines->overlappedWrites;
+    if (!sim->executing) {
+        sim->executing = 1;
+        ++sim->lines->executing;
+    }
+    ++sim->transfers;
+
+    if (sim->lines->rs) {
+        if (!sim->cgramSelected) {
+            sim->ddram[sim->addressCounter] = value;
+            advanceAddressCounter(sim);
+        }
+    } else {
+        if (value < (RETURN_HOME << 1))
+            executionTime = LCD_EXECUTION_TIME_LONG_US;
+        executeInstruction(sim, value);
+    }
+    sim->busyUntil = Timestamp_microseconds() + executionTime;
+}
+
+static void
+driveDataLines(LCDSimLines * lines, int8_t hostDriving)
+{
+    if (lines->hostDriving != hostDriving)
+        ++lines->turnarounds;
+    lines->hostDriving = hostDriving;
+}
+
+static void
+executeInstruction(LCDSim * sim, int32_t instr)
+{
+    if (instr & SET_DDRAM_ADDRESS_CMD) {
+        sim->addressCounter = instr & (LCDSIM_DDRAM_SIZE - 1);
+        sim->cgramSelected = 0;
+    } else if (instr & SET_CGRAM_ADDRESS_CMD) {
+        sim->cgramSelected = 1;
+    } else if (instr & FUNCTION_SET) {
+        sim->functionSet = instr;
+    } else if (DISPLAY_CLEAR == instr) {
+        memset(sim->ddram, ' ', sizeof(sim->ddram));
+        sim->addressCounter = 0;
+        sim->cgramSelected = 0;
+        sim->displayShift = 0;
+    } else if (RETURN_HOME == (instr & ~DISPLAY_CLEAR)) {
+        sim->addressCounter = 0;
+        sim->cgramSelected = 0;
+        sim->displayShift = 0;
+    } else if ((instr & ~0x07)
+            == (CURSOR_OR_DISPLAY_SHIFT | CURSOR_OR_DISPLAY_SHIFT__DISPLAY)) {
+        sim->displayShift = (instr & CURSOR_OR_DISPLAY_SHIFT__RIGHT) ?
+            (sim->displayShift + DDRAM_LINE_LENGTH - 1) % DDRAM_LINE_LENGTH :
+            (sim->displayShift + 1) % DDRAM_LINE_LENGTH;
+    } else if ((instr & ~0x07) == DISPLAY_CONTROL) {
+        sim->displayControl = instr;
+    }
+}
+
+/*   The address counter follows the auto-increment of the 2-line mode. */
+static void
+advanceAddressCounter(LCDSim * sim)
+{
+    if (DDRAM_1ST_LINE_LAST_ADDR == sim->addressCounter)
+        sim->addressCounter = DDRAM_2ND_LINE_ADDR;
+    else if (DDRAM_2ND_LINE_LAST_ADDR == sim->addressCounter)
+        sim->addressCounter = 0;
+    else
+        ++sim->addressCounter;
+}
+
+static int32_t
+readRegister(LCDSim * sim)
+{
+    ++sim->reads;
+    if (sim->lines->rs)
+        return (sim->cgramSelected) ? 0 : sim->ddram[sim->addressCounter];
+    if (LCDSim_IsBusy(sim))
+        return READ_INSTRUCTION__BUSY_FLAG_MASK | sim->addressCounter;
+
+    if (sim->executing) {
+        sim->executing = 0;
+        --sim->lines->executing;
+    }
+
+    return sim->addressCounter;
+}
+
+/*   Every line change goes to all the controllers of the group: to each
+ * one's E, and, harmlessly, to their common lines again.
+ */
+static void
+groupInit(void * port, int32_t lcdPortDataWidth)
+{
+    LCDSimGroup * group = port;
+    size_t i;
+
+    for (i = 0; i < group->count; ++i)
+        init(group->sims[i], lcdPortDataWidth);
+}
+
+static void
+groupDeinit(void * port)
+{
+    forEachInGroup(port, deinit);
+}
+
+static void
+groupSetDirection_Input(void * port)
+{
+    forEachInGroup(port, setDirection_Input);
+}
+
+static void
+groupSetDirection_Output(void * port)
+{
+    forEachInGroup(port, setDirection_Output);
+}
+
+static void
+groupOut4(void * port, int32_t n)
+{
+    LCDSimGroup * group = port;
+    size_t i;
+
+    for (i = 0; i < group->count; ++i)
+        out4(group->sims[i], n);
+}
+
+static void
+groupOut8(void * port, int32_t n)
+{
+    LCDSimGroup * group = port;
+    size_t i;
+
+    for (i = 0; i < group->count; ++i)
+        out8(group->sims[i], n);
+}
+
+static int32_t
+groupIn4(void * port)
+{
+    return in4(answerOfGroup(port));
+}
+
+static int32_t
+groupIn8(void * port)
+{
+    return in8(answerOfGroup(port));
+}
+
+static void
+groupSetRS(void * port)
+{
+    forEachInGroup(port, setRS);
+}
+
+static void
+groupClearRS(void * port)
+{
+    forEachInGroup(port, clearRS);
+}
+
+static void
+groupSetRW(void * port)
+{
+    forEachInGroup(port, setRW);
+}
+
+static void
+groupClearRW(void * port)
+{
+    forEachInGroup(port, clearRW);
+}
+
+static void
+groupSetCE(void * port)
+{
+    forEachInGroup(port, setCE);
+}
+
+static void
+groupClearCE(void * port)
+{
+    forEachInGroup(port, clearCE);
+}
+
+static void
+forEachInGroup(LCDSimGroup * group, void (*op)(void *))
+{
+    size_t i;
+
+    for (i = 0; i < group->count; ++i)
+        op(group->sims[i]);
+}
+
+/*   Several controllers selected for a read drive the data lines against
+ * each other; the first one is taken to win.
+ */
+static LCDSim *
+answerOfGroup(LCDSimGroup * group)
+{
+    if (1 < group->count)
+        ++group->collisions;
+
+    return group->sims[0];
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2016, Taras Korenko
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_LCDSim_h
+#define D_LCDSim_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LCDPort.h"
+
+/*   A simulated HD44780 on an 8-bit bus, for host tests.  The controller
+ * latches a transfer on the falling edge of E and stays busy for the
+ * execution time of the operation, measured by Timestamp_microseconds().
+ * Only DDRAM is modelled: CGRAM transfers are taken and dropped, as are
+ * the instructions other than CLEAR, RETURN HOME and SET DDRAM ADDRESS.
+ *   Every instance is a port on its own: LCDSim_Ops expect the LCDSim as
+ * the port handle, LCDSim_BusCycleOps do too and take whole bus cycles.  Controllers attached to a common LCDSimLines share RS,
+ * RW and the data lines; E stays their own.
+ *   A controller executes from a write until the host reads its busy flag
+ * clear.  The lines count the writes latched while another controller of
+ * theirs was executing: by the host's events, not by the clock.
+ */
+enum {
+    LCDSIM_DDRAM_SIZE = 0x80,
+};
+
+typedef struct LCDSimLines {
+    int8_t   rs;
+    int8_t   rw;
+    int32_t  dataLines;             // as driven by the host
+    int8_t   hostDriving;           // data lines are host outputs
+    uint32_t floatingWrites;        // latched off undriven data lines
+    uint32_t turnarounds;           // data lines direction changes
+    uint8_t  executing;             // controllers not seen ready yet
+    uint32_t overlappedWrites;      // latched while another one executed
+} LCDSimLines;
+
+typedef struct LCDSim {
+    LCDSimLines ownLines;
+    LCDSimLines * lines;
+    int8_t   ce;
+    uint8_t  ddram[LCDSIM_DDRAM_SIZE];
+    uint8_t  addressCounter;
+    uint8_t  displayShift;          // columns shifted to the left
+    uint8_t  functionSet;           // the last FUNCTION SET latched
+    uint8_t  displayControl;        // the last DISPLAY CONTROL latched
+    int8_t   cgramSelected;
+    int8_t   executing;             // written, not seen ready since
+    uint32_t busyUntil;
+    uint32_t transfers;
+    uint32_t portOperations;        // port operations the host called
+    uint32_t reads;                 // register (busy flag included) reads
+    uint32_t writesWhileBusy;       // the host did not wait
+} LCDSim;
+
+/*   A port raising the E lines of several controllers together, as a
+ * board does for a broadcast: LCDSimGroup_Ops expect the LCDSimGroup as
+ * the port handle.  A read through it counts as a collision.
+ */
+enum {
+    LCDSIM_GROUP_SIZE = 8,
+};
+
+typedef struct LCDSimGroup {
+    LCDSim * sims[LCDSIM_GROUP_SIZE];
+    size_t   count;
+    uint32_t collisions;            // controllers answered together
+} LCDSimGroup;
+
+extern const LCDPortOps LCDSim_Ops;
+extern const LCDPortOps LCDSim_BusCycleOps;
+extern const LCDPortOps LCDSimGroup_Ops;
+
+void    LCDSim_Init(LCDSim * sim);
+void    LCDSim_AttachToLines(LCDSim * sim, LCDSimLines * lines);
+int32_t LCDSim_IsBusy(LCDSim * sim);
+uint8_t LCDSim_ShownChar(LCDSim * sim, int16_t line, int16_t column);
+
+void    LCDSimGroup_Init(LCDSimGroup * group);
+int32_t LCDSimGroup_Add(LCDSimGroup * group, LCDSim * sim);
+
+#endif /* #ifndef D_LCDSim_h */
@@ -0,0 +1,540 @@
+#include "CppUTest/TestHarness.h"
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+extern "C" {
+#include "LCDIntf.h"
+#include "LCDDriver.h"
+#include "LCDSim.h"
+}
+
+/* ====================================================================== */
+/*   The whole stack (LCDDriver, LCDIntf, port) against simulated         */
+/* controllers, on the real clock.                                        */
+/* ====================================================================== */
+struct SimulatedDisplay {
+    LCDSim sim;
+    LCDIntf intf;
+    LCDDriver lcd;
+};
+
+static void
+bringUpOn(SimulatedDisplay * d, const LCDPortOps * ops, int32_t busyMode)
+{
+    LCDSim_Init(&d->sim);
+    LCDIntf_Init(&d->intf, ops, &d->sim, LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDIntf_SetBusyMode(&d->intf, busyMode);
+    LCDIntf_InitializeLCDController(&d->intf);
+    LCDDriver_Init(&d->lcd, &d->intf);
+    LCDDriver_SetupScreenDimensions(&d->lcd, 16, 2);
+}
+
+static void
+bringUp(SimulatedDisplay * d, int32_t busyMode)
+{
+    bringUpOn(d, &LCDSim_Ops, busyMode);
+}
+
+/*   Leaves the controller initializing, with nothing written yet. */
+static void
+startBringUp(SimulatedDisplay * d)
+{
+    LCDSim_Init(&d->sim);
+    LCDIntf_Init(&d->intf, &LCDSim_Ops, &d->sim, LCD_PORT_DATA_WIDTH_8_BIT);
+    LCDIntf_StartLCDControllerInit(&d->intf);
+}
+
+TEST_GROUP(ASimulatedDisplay)
+{
+    SimulatedDisplay display;
+
+    void setup() override {
+        bringUp(&display, LCD_BUSY_MODE_POLL);
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&display.intf);
+    }
+};
+
+TEST(ASimulatedDisplay, ShowsTextWhereTheCursorWasMoved) {
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_GotoXY(&display.lcd, 3, 1));
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDDriver_Puts(&display.lcd, (int8_t *)"abc"));
+
+    MEMCMP_EQUAL("abc", &display.sim.ddram[0x43], 3);
+}
+
+TEST(ASimulatedDisplay, IsNeverWrittenWhileBusy) {
+    LCDDriver_Clear(&display.lcd);
+    LCDDriver_Puts(&display.lcd, (int8_t *)"0123456789ABCDEF");
+
+    CHECK(display.sim.transfers > 16);
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+    LONGS_EQUAL(0, display.sim.lines->floatingWrites);
+}
+
+TEST(ASimulatedDisplay, IsReadBackIntoTheShadow) {
+    LCDDriver_Puts(&display.lcd, (int8_t *)"warm");
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_LoadShadow(&display.lcd));
+
+    MEMCMP_EQUAL("warm", display.lcd.shadowCells, 4);
+}
+
+TEST(ASimulatedDisplay, IsNeverWrittenWhileBusyWithPredictedReadiness) {
+    LCDIntf_Deinit(&display.intf);
+    bringUp(&display, LCD_BUSY_MODE_PREDICT);
+
+    LCDDriver_Clear(&display.lcd);
+    LCDDriver_Puts(&display.lcd, (int8_t *)"0123456789ABCDEF");
+
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+    MEMCMP_EQUAL("0123456789ABCDEF", display.sim.ddram, 16);
+}
+
+TEST(ASimulatedDisplay, TakesAPredictedBurstWithASingleTurnaround) {
+    const uint8_t text[] = "0123456789ABCDEF";
+
+    LCDIntf_Deinit(&display.intf);
+    bringUp(&display, LCD_BUSY_MODE_PREDICT);
+    uint32_t turnarounds = display.sim.lines->turnarounds;
+    uint32_t reads = display.sim.reads;
+
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDIntf_WriteDataBurst(&display.intf, text, 16));
+
+    LONGS_EQUAL(1, display.sim.lines->turnarounds - turnarounds);
+    LONGS_EQUAL(0, display.sim.reads - reads);
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+    MEMCMP_EQUAL(text, display.sim.ddram, 16);
+}
+
+TEST(ASimulatedDisplay, TakesFewerPortOperationsForABurstThanByteByByte) {
+    const uint8_t text[] = "0123456789ABCDEF";
+
+    LCDIntf_Deinit(&display.intf);
+    bringUp(&display, LCD_BUSY_MODE_PREDICT);
+    uint32_t before = display.sim.portOperations;
+    for (int i = 0; i < 16; ++i)
+        LCDIntf_WriteData(&display.intf, text[i]);
+    uint32_t byteByByte = display.sim.portOperations - before;
+
+    before = display.sim.portOperations;
+    LCDIntf_WriteDataBurst(&display.intf, text, 16);
+    uint32_t burst = display.sim.portOperations - before;
+
+    CHECK(burst < byteByByte);
+    // E up, the byte, E down: the register and the bus are set up once
+    CHECK(burst <= 3 * 16 + 3);
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+    MEMCMP_EQUAL(text, &display.sim.ddram[16], 16);
+}
+
+TEST(ASimulatedDisplay, ShowsTextThroughWholeBusCycles) {
+    LCDIntf_Deinit(&display.intf);
+    bringUpOn(&display, &LCDSim_BusCycleOps, LCD_BUSY_MODE_PREDICT);
+    uint32_t before = display.sim.portOperations;
+
+    LONGS_EQUAL(LCD_OPERATION_OK,
+        LCDDriver_Puts(&display.lcd, (int8_t *)"abc"));
+
+    // a single write cycle per character
+    LONGS_EQUAL(3, display.sim.portOperations - before);
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+    MEMCMP_EQUAL("abc", display.sim.ddram, 3);
+}
+
+TEST(ASimulatedDisplay, KeepsWritesThatOverflowTheQueueDuringInit) {
+    enum { N = LCD_INTF_QUEUE_SIZE + 8 };
+    uint8_t text[N];
+
+    LCDIntf_Deinit(&display.intf);
+    startBringUp(&display);
+    for (int i = 0; i < N; ++i) {
+        text[i] = 'A' + i % 26;
+        LCDIntf_WriteData(&display.intf, text[i]);
+        LCDIntf_WaitWhileBusy(&display.intf);   // pending during the init
+    }
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Drain(&display.intf));
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_GetInitStatus(&display.intf));
+    LONGS_EQUAL(0, LCDIntf_GetQueueOverflows(&display.intf));
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+    MEMCMP_EQUAL(text, display.sim.ddram, N);
+}
+
+TEST(ASimulatedDisplay, WritesABurstThatDoesNotFitTheQueueAfterInit) {
+    enum { QUEUED = LCD_INTF_QUEUE_SIZE - 4, N = QUEUED + 8 };
+    uint8_t text[N];
+
+    LCDIntf_Deinit(&display.intf);
+    startBringUp(&display);
+    for (int i = 0; i < N; ++i)
+        text[i] = 'a' + i % 26;
+    for (int i = 0; i < QUEUED; ++i) {
+        LCDIntf_WriteData(&display.intf, text[i]);
+        LCDIntf_WaitWhileBusy(&display.intf);
+    }
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_WriteDataBurst(&display.intf,
+        &text[QUEUED], N - QUEUED));
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_Drain(&display.intf));
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDIntf_GetInitStatus(&display.intf));
+    LONGS_EQUAL(0, LCDIntf_GetQueueOverflows(&display.intf));
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+    MEMCMP_EQUAL(text, display.sim.ddram, N);
+}
+
+/* ====================================================================== */
+/*   A marquee in the lower row of the 16x2 display: the text and a gap   */
+/* of 16 blanks go round, one column per step.                           */
+/* ====================================================================== */
+static const char longText[] =
+    "A text that is much longer than the forty DDRAM columns";
+
+TEST_GROUP(AMarqueeOnASimulatedDisplay)
+{
+    SimulatedDisplay display;
+
+    void setup() override {
+        bringUp(&display, LCD_BUSY_MODE_POLL);
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&display.intf);
+    }
+
+    void start(const char * text) {
+        LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_StartMarquee(&display.lcd,
+            1, (const int8_t *)text));
+    }
+
+    void checkShownFrom(const char * text, int32_t pos) {
+        int32_t length = strlen(text), period = length + 16;
+
+        if (period < 40)
+            period = 40;
+        for (int16_t x = 0; x < 16; ++x) {
+            int32_t i = (pos + x) % period;
+            LONGS_EQUAL((i < length) ? text[i] : ' ',
+                LCDSim_ShownChar(&display.sim, 1, x));
+        }
+    }
+};
+
+TEST(AMarqueeOnASimulatedDisplay, ShowsTheStartOfTheText) {
+    start(longText);
+
+    checkShownFrom(longText, 0);
+}
+
+TEST(AMarqueeOnASimulatedDisplay, ShowsTextFurtherOnWithEveryStep) {
+    start(longText);
+
+    for (int32_t step = 1; step < 3 * (int32_t)sizeof(longText); ++step) {
+        LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_StepMarquee(&display.lcd));
+        checkShownFrom(longText, step);
+    }
+    LONGS_EQUAL(0, display.sim.writesWhileBusy);
+}
+
+TEST(AMarqueeOnASimulatedDisplay, TakesOneTransferForMostSteps) {
+    int32_t steps = 200, singleTransferSteps = 0;
+
+    start(longText);
+    for (int32_t step = 0; step < steps; ++step) {
+        uint32_t transfers = display.sim.transfers;
+
+        LCDDriver_StepMarquee(&display.lcd);
+        if (display.sim.transfers - transfers == 1)
+            ++singleTransferSteps;
+    }
+
+    CHECK(singleTransferSteps > 9 * steps / 10);
+    CHECK(display.sim.transfers < 3 * (uint32_t)steps);
+}
+
+TEST(AMarqueeOnASimulatedDisplay, LoadsShortTextOnlyOnce) {
+    start("short");
+    uint32_t transfers = display.sim.transfers;
+
+    for (int32_t step = 1; step <= 100; ++step) {
+        LCDDriver_StepMarquee(&display.lcd);
+        checkShownFrom("short", step);
+    }
+
+    LONGS_EQUAL(100, display.sim.transfers - transfers);
+}
+
+TEST(AMarqueeOnASimulatedDisplay, ShiftsDisplayHomeWhenStopped) {
+    start(longText);
+    LCDDriver_StepMarquee(&display.lcd);
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_StopMarquee(&display.lcd));
+    LCDDriver_GotoXY(&display.lcd, 0, 0);
+    LCDDriver_Puts(&display.lcd, (int8_t *)"top");
+
+    LONGS_EQUAL(0, display.sim.displayShift);
+    LONGS_EQUAL('t', LCDSim_ShownChar(&display.sim, 0, 0));
+    LONGS_EQUAL(LCD_OPERATION_NOT_CONFIGURED,
+        LCDDriver_StepMarquee(&display.lcd));
+}
+
+/* ====================================================================== */
+/*   Every thread drives a display of its own: instances share no state, */
+/* so each display ends up with its own text only.                       */
+/* ====================================================================== */
+enum {
+    DISPLAYS = 4,
+    ROUNDS_PER_DISPLAY = 200,
+};
+
+struct DisplayOfThread {
+    SimulatedDisplay display;
+    char text[17];
+    uint32_t failures;
+};
+
+static void *
+drawRepeatedly(void * arg)
+{
+    DisplayOfThread * t = (DisplayOfThread *)arg;
+    LCDDriver * lcd = &t->display.lcd;
+
+    for (int i = 0; i < ROUNDS_PER_DISPLAY; ++i) {
+        if (LCD_OPERATION_OK != LCDDriver_GotoXY(lcd, 0, i & 0x01))
+            ++t->failures;
+        if (LCD_OPERATION_OK != LCDDriver_Puts(lcd, (int8_t *)t->text))
+            ++t->failures;
+    }
+
+    return NULL;
+}
+
+TEST_GROUP(SimulatedDisplays_Threaded)
+{
+};
+
+TEST(SimulatedDisplays_Threaded, KeepTheirOwnTextWhenDrivenInParallel) {
+    static DisplayOfThread threads[DISPLAYS];
+    pthread_t ids[DISPLAYS];
+
+    for (int i = 0; i < DISPLAYS; ++i) {
+        bringUp(&threads[i].display, (i & 0x01) ?
+            LCD_BUSY_MODE_PREDICT : LCD_BUSY_MODE_POLL);
+        memset(threads[i].text, 'a' + i, 16);
+        threads[i].text[16] = '\0';
+        threads[i].failures = 0;
+    }
+
+    for (int i = 0; i < DISPLAYS; ++i)
+        pthread_create(&ids[i], NULL, drawRepeatedly, &threads[i]);
+    for (int i = 0; i < DISPLAYS; ++i)
+        pthread_join(ids[i], NULL);
+
+    for (int i = 0; i < DISPLAYS; ++i) {
+        LCDSim * sim = &threads[i].display.sim;
+
+        LONGS_EQUAL(0, threads[i].failures);
+        LONGS_EQUAL(0, sim->writesWhileBusy);
+        MEMCMP_EQUAL(threads[i].text, &sim->ddram[0x00], 16);
+        MEMCMP_EQUAL(threads[i].text, &sim->ddram[0x40], 16);
+        LCDIntf_Deinit(&threads[i].display.intf);
+    }
+}
+
+/* ====================================================================== */
+/*   A 40x4 module: two controllers on common lines, an E line each.      */
+/* ====================================================================== */
+enum {
+    WIDE_SCREEN_WIDTH = 40,
+    WIDE_SCREEN_HEIGHT = 4,
+};
+
+TEST_GROUP(ADualControllerDisplay)
+{
+    LCDSimLines lines;
+    LCDSim upperSim, lowerSim;
+    LCDIntf upperIntf, lowerIntf;
+    LCDDriver lcd;
+
+    void setup() override {
+        memset(&lines, 0, sizeof(lines));
+        bringUpController(&upperSim, &upperIntf);
+        bringUpController(&lowerSim, &lowerIntf);
+        LCDIntf_ShareBus(&lowerIntf, &upperIntf);
+
+        LCDDriver_Init(&lcd, &upperIntf);
+        LONGS_EQUAL(LCD_OPERATION_OK,
+            LCDDriver_AddController(&lcd, &lowerIntf));
+        LONGS_EQUAL(LCD_OPERATION_OK,
+            LCDDriver_SetupGeometry(&lcd, &LCDGeometry_40x4));
+    }
+
+    void teardown() override {
+        LCDIntf_Deinit(&upperIntf);
+        LCDIntf_Deinit(&lowerIntf);
+    }
+
+    void bringUpController(LCDSim * sim, LCDIntf * intf) {
+        LCDSim_Init(sim);
+        LCDSim_AttachToLines(sim, &lines);
+        LCDIntf_Init(intf, &LCDSim_Ops, sim, LCD_PORT_DATA_WIDTH_8_BIT);
+        LCDIntf_InitializeLCDController(intf);
+    }
+
+    void drawFullScreen(LCDDriver * d, int16_t rows, char first) {
+        char row[WIDE_SCREEN_WIDTH + 1];
+
+        row[WIDE_SCREEN_WIDTH] = '\0';
+        for (int16_t y = 0; y < rows; ++y) {
+            memset(row, first + y, WIDE_SCREEN_WIDTH);
+            LCDDriver_GotoXY(d, 0, y);
+            LCDDriver_Puts(d, (int8_t *)row);
+        }
+    }
+
+    void checkNothingWasWrittenWhileBusy() {
+        LONGS_EQUAL(0, upperSim.writesWhileBusy);
+        LONGS_EQUAL(0, lowerSim.writesWhileBusy);
+        LONGS_EQUAL(0, lines.floatingWrites);
+    }
+
+    uint32_t transfers() {
+        return upperSim.transfers + lowerSim.transfers;
+    }
+
+    // writes to one controller while the other executed, see LCDSim.h
+    uint32_t refreshSideBySide(char first) {
+        uint32_t before = lines.overlappedWrites;
+
+        drawFullScreen(&lcd, WIDE_SCREEN_HEIGHT, first);
+        LCDDriver_Flush(&lcd);
+
+        return lines.overlappedWrites - before;
+    }
+
+    // the halves as two 40x2 displays, flushed one after the other
+    uint32_t refreshOneAfterAnother(LCDDriver * upper, LCDDriver * lower,
+            char first) {
+        uint32_t before = lines.overlappedWrites;
+
+        drawFullScreen(upper, 2, first);
+        LCDDriver_Flush(upper);
+        drawFullScreen(lower, 2, first + 2);
+        LCDDriver_Flush(lower);
+
+        return lines.overlappedWrites - before;
+    }
+};
+
+TEST(ADualControllerDisplay, TakesNoMoreThanTwoControllers) {
+    LONGS_EQUAL(LCD_OPERATION_UNSUPPORTED,
+        LCDDriver_AddController(&lcd, &lowerIntf));
+}
+
+TEST(ADualControllerDisplay, RoutesLowerRowsToSecondController) {
+    LCDDriver_GotoXY(&lcd, 5, 2);
+    LCDDriver_Puts(&lcd, (int8_t *)"third");
+    LCDDriver_GotoXY(&lcd, 39, 3);
+    LCDDriver_Putc(&lcd, '4');
+    LCDDriver_GotoXY(&lcd, 0, 1);
+    LCDDriver_Putc(&lcd, '2');
+
+    MEMCMP_EQUAL("third", &lowerSim.ddram[0x05], 5);
+    LONGS_EQUAL('4', lowerSim.ddram[0x67]);
+    LONGS_EQUAL('2', upperSim.ddram[0x40]);
+    LONGS_EQUAL(' ', upperSim.ddram[0x05]);
+    checkNothingWasWrittenWhileBusy();
+}
+
+TEST(ADualControllerDisplay, WrapsTextIntoRowsOfTheOtherController) {
+    int16_t written;
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_PutText(&lcd, 36, 1,
+        (const int8_t *)"abcdefgh\nxyz", LCDDRIVER_TEXT_WRAP, &written));
+
+    LONGS_EQUAL(11, written);
+    MEMCMP_EQUAL("abcd", &upperSim.ddram[0x40 + 36], 4);
+    MEMCMP_EQUAL("efgh", &lowerSim.ddram[0x00], 4);
+    MEMCMP_EQUAL("xyz", &lowerSim.ddram[0x40], 3);
+    checkNothingWasWrittenWhileBusy();
+}
+
+TEST(ADualControllerDisplay, ClearsBothControllers) {
+    LCDDriver_GotoXY(&lcd, 0, 0);
+    LCDDriver_Putc(&lcd, 'a');
+    LCDDriver_GotoXY(&lcd, 0, 3);
+    LCDDriver_Putc(&lcd, 'b');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Clear(&lcd));
+
+    LONGS_EQUAL(' ', upperSim.ddram[0x00]);
+    LONGS_EQUAL(' ', lowerSim.ddram[0x40]);
+}
+
+TEST(ADualControllerDisplay, FlushesEveryRowToItsController) {
+    char row[WIDE_SCREEN_WIDTH];
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_EnableShadow(&lcd));
+    drawFullScreen(&lcd, WIDE_SCREEN_HEIGHT, 'a');
+
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Flush(&lcd));
+
+    memset(row, 'a', sizeof(row));
+    MEMCMP_EQUAL(row, &upperSim.ddram[0x00], sizeof(row));
+    memset(row, 'b', sizeof(row));
+    MEMCMP_EQUAL(row, &upperSim.ddram[0x40], sizeof(row));
+    memset(row, 'c', sizeof(row));
+    MEMCMP_EQUAL(row, &lowerSim.ddram[0x00], sizeof(row));
+    memset(row, 'd', sizeof(row));
+    MEMCMP_EQUAL(row, &lowerSim.ddram[0x40], sizeof(row));
+    checkNothingWasWrittenWhileBusy();
+}
+
+TEST(ADualControllerDisplay, FlushesChangedCellsOnly) {
+    LCDDriver_EnableShadow(&lcd);
+    drawFullScreen(&lcd, WIDE_SCREEN_HEIGHT, 'a');
+    LCDDriver_Flush(&lcd);
+    uint32_t upperTransfers = upperSim.transfers;
+    uint32_t lowerTransfers = lowerSim.transfers;
+
+    LCDDriver_GotoXY(&lcd, 10, 3);
+    LCDDriver_Putc(&lcd, 'X');
+    LONGS_EQUAL(LCD_OPERATION_OK, LCDDriver_Flush(&lcd));
+
+    LONGS_EQUAL('X', lowerSim.ddram[0x40 + 10]);
+    LONGS_EQUAL(upperTransfers, upperSim.transfers);
+    LONGS_EQUAL(lowerTransfers + 2, lowerSim.transfers);
+}
+
+/*   Best of a few runs, to keep the host scheduler out of the figures. */
+/*   Counted by the simulators, not timed: a refresh takes about half the
+ * time of one after another when nearly all of its writes go to one
+ * controller while the other executes.
+ */
+TEST(ADualControllerDisplay, RefreshesInAboutHalfTheTimeOfOneAfterAnother) {
+    LCDDriver upper, lower;
+    uint32_t sideBySide, oneAfterAnother, writes;
+
+    LCDDriver_EnableShadow(&lcd);
+    LCDDriver_Init(&upper, &upperIntf);
+    LCDDriver_SetupGeometry(&upper, &LCDGeometry_40x2);
+    LCDDriver_EnableShadow(&upper);
+    LCDDriver_Init(&lower, &lowerIntf);
+    LCDDriver_SetupGeometry(&lower, &LCDGeometry_40x2);
+    LCDDriver_EnableShadow(&lower);
+
+    writes = transfers();
+    sideBySide = refreshSideBySide('a');
+    writes = transfers() - writes;
+    oneAfterAnother = refreshOneAfterAnother(&upper, &lower, 'A');
+
+    CHECK(writes > 0);
+    CHECK(3 * sideBySide > 2 * writes);
+    LONGS_EQUAL(0, oneAfterAnother);
+    checkNothingWasWrittenWhileBusy();
+}
@@ -0,0 +1,46 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+#include "LCDTime.h"
+}
+
+/* ====================================================================== */
+/*   The host implementation of LCDTime, checked against its own clock.   */
+/* ====================================================================== */
+TEST_GROUP(AnLCDTime_Host)
+{
+    void setup() override {
+        LCDTime_Init();
+    }
+};
+
+TEST(AnLCDTime_Host, TimestampDoesNotGoBackwards) {
+    uint32_t before = Timestamp_microseconds();
+    uint32_t after = Timestamp_microseconds();
+
+    CHECK((int32_t)(after - before) >= 0);
+}
+
+TEST(AnLCDTime_Host, DelaysAtLeastRequestedTime) {
+    uint32_t start = Timestamp_microseconds();
+
+    Delay_microseconds(37);
+
+    CHECK(Timestamp_microseconds() - start >= 37);
+}
+
+TEST(AnLCDTime_Host, DelaysLongerThanAMillisecond) {
+    uint32_t start = Timestamp_microseconds();
+
+    Delay_microseconds(1520);
+
+    CHECK(Timestamp_microseconds() - start >= 1520);
+}
+
+TEST(AnLCDTime_Host, ReturnsAtOnceForNoDelay) {
+    uint32_t start = Timestamp_microseconds();
+
+    Delay_microseconds(0);
+
+    CHECK(Timestamp_microseconds() - start < 1000);
+}